@@ -0,0 +1,481 @@
+// DSP micro-benchmarks: every component on its own, then the whole engine
+// across sample rates, block sizes, stereo modes, freeze and ducking.
+// Results are JSON, so runs before and after a change can be diffed.
+//
+//   chronos_bench [--out results.json] [--filter text] [--min-time seconds] [--full]
+
+#include "BufferArena.h"
+#include "DelayEngine.h"
+#include "DelayLine.h"
+#include "DuckingEnvelope.h"
+#include "FeedbackProcessor.h"
+#include "ModulationLFO.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__SSE__) || defined(_M_X64)
+ #include <xmmintrin.h>
+#endif
+
+using namespace Chronos;
+
+namespace {
+
+using Params = std::vector<std::pair<std::string, std::string>>;
+
+struct Result
+{
+    std::string name;
+    Params params;
+    double nsPerSample = 0.0;   // Median pass
+    double minNsPerSample = 0.0;
+    int passes = 0;
+};
+
+// Keeps results observable so the optimizer cannot drop the work
+volatile float sink = 0.0f;
+
+class Runner
+{
+public:
+    double minTime = 0.25;      // Seconds of timed passes per case
+    std::string filter;
+    std::vector<Result> results;
+
+    // pass() processes samplesPerPass samples; setup() (untimed) runs before
+    // each pass
+    void run(const std::string& name, const Params& params, long samplesPerPass,
+             const std::function<void()>& pass, const std::function<void()>& setup = {})
+    {
+        if (!filter.empty() && (name + " " + describe(params)).find(filter) == std::string::npos)
+            return;
+
+        using Clock = std::chrono::steady_clock;
+        std::vector<double> times;
+        double total = 0.0;
+
+        // One untimed pass to warm caches and branch predictors
+        if (setup)
+            setup();
+        pass();
+
+        while (total < minTime || times.size() < 5)
+        {
+            if (setup)
+                setup();
+
+            auto start = Clock::now();
+            pass();
+            double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+            times.push_back(seconds);
+            total += seconds;
+        }
+
+        std::sort(times.begin(), times.end());
+
+        Result result;
+        result.name = name;
+        result.params = params;
+        result.nsPerSample = times[times.size() / 2] * 1e9 / static_cast<double>(samplesPerPass);
+        result.minNsPerSample = times.front() * 1e9 / static_cast<double>(samplesPerPass);
+        result.passes = static_cast<int>(times.size());
+        results.push_back(result);
+
+        std::fprintf(stderr, "%-28s %-60s %9.2f ns/sample\n", name.c_str(), describe(params).c_str(), result.nsPerSample);
+    }
+
+    static std::string describe(const Params& params)
+    {
+        std::string text;
+        for (const auto& [key, value] : params)
+            text += (text.empty() ? "" : " ") + key + "=" + value;
+        return text;
+    }
+};
+
+std::vector<float> makeNoise(size_t count, float level, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-level, level);
+    std::vector<float> noise(count);
+    for (auto& sample : noise)
+        sample = dist(rng);
+    return noise;
+}
+
+const char* filterModeName(FilterMode mode)
+{
+    switch (mode)
+    {
+        case FilterMode::LowPass:  return "lowpass";
+        case FilterMode::HighPass: return "highpass";
+        default:                   return "bandpass";
+    }
+}
+
+const char* lfoShapeName(LFOShape shape)
+{
+    switch (shape)
+    {
+        case LFOShape::Sine:     return "sine";
+        case LFOShape::Triangle: return "triangle";
+        case LFOShape::Random:   return "random";
+        default:                 return "smoothrandom";
+    }
+}
+
+const char* stereoModeName(StereoMode mode)
+{
+    switch (mode)
+    {
+        case StereoMode::Mono:     return "mono";
+        case StereoMode::Stereo:   return "stereo";
+        case StereoMode::PingPong: return "pingpong";
+        default:                   return "wide";
+    }
+}
+
+// === Components ===
+
+constexpr long componentSamples = 1 << 16;
+
+void benchDelayLine(Runner& runner, float sampleRate)
+{
+    auto line = std::make_shared<DelayLine>();
+    line->prepare(sampleRate, 2000.0f);
+    auto input = std::make_shared<std::vector<float>>(makeNoise(componentSamples, 0.5f, 1));
+
+    // Slowly swept delay, as under modulation
+    const float baseDelay = line->msToSamples(500.0f);
+    const Params params = { { "sample_rate", std::to_string(static_cast<int>(sampleRate)) } };
+
+    runner.run("delayline/read", params, componentSamples, [=]
+    {
+        float acc = 0.0f;
+        for (long i = 0; i < componentSamples; ++i)
+        {
+            line->write((*input)[static_cast<size_t>(i)]);
+            acc += line->read(baseDelay + static_cast<float>(i & 1023) * 0.01f);
+        }
+        sink = acc;
+    });
+
+    runner.run("delayline/readLinear", params, componentSamples, [=]
+    {
+        float acc = 0.0f;
+        for (long i = 0; i < componentSamples; ++i)
+        {
+            line->write((*input)[static_cast<size_t>(i)]);
+            acc += line->readLinear(baseDelay + static_cast<float>(i & 1023) * 0.01f);
+        }
+        sink = acc;
+    });
+}
+
+void benchFeedbackProcessor(Runner& runner, float sampleRate)
+{
+    constexpr int blockSize = 256;
+    auto input = std::make_shared<std::vector<float>>(makeNoise(componentSamples, 0.5f, 2));
+    auto output = std::make_shared<std::vector<float>>(componentSamples);
+
+    for (auto mode : { FilterMode::LowPass, FilterMode::HighPass, FilterMode::BandPass })
+    {
+        for (float drive : { 0.0f, 0.5f })
+        {
+            auto arena = std::make_shared<BufferArena>();
+            auto processor = std::make_shared<FeedbackProcessor>();
+            processor->prepare(sampleRate, blockSize, *arena);
+            processor->setFilterParams(4000.0f, 0.3f, mode);
+            processor->setDamping(0.3f);
+            processor->setSaturationAccuracy(SaturationAccuracy::High);
+            processor->setOversamplingEnabled(drive > 0.0f);
+
+            const Params params = {
+                { "sample_rate", std::to_string(static_cast<int>(sampleRate)) },
+                { "mode", filterModeName(mode) },
+                { "drive", drive > 0.0f ? "0.5" : "0" }
+            };
+
+            runner.run("feedback/process", params, componentSamples, [=]
+            {
+                float acc = 0.0f;
+                for (long i = 0; i < componentSamples; ++i)
+                    acc += processor->process((*input)[static_cast<size_t>(i)], drive);
+                sink = acc;
+            });
+
+            runner.run("feedback/processBlock", params, componentSamples, [=]
+            {
+                for (long i = 0; i < componentSamples; i += blockSize)
+                    processor->processBlock(input->data() + i, output->data() + i, blockSize, drive);
+                sink = (*output)[0];
+            });
+        }
+    }
+}
+
+void benchLFO(Runner& runner, float sampleRate)
+{
+    constexpr int blockSize = 256;
+    auto output = std::make_shared<std::vector<float>>(blockSize);
+
+    for (auto shape : { LFOShape::Sine, LFOShape::Triangle, LFOShape::Random, LFOShape::SmoothRandom })
+    {
+        for (bool controlRate : { false, true })
+        {
+            auto lfo = std::make_shared<ModulationLFO>();
+            lfo->prepare(sampleRate);
+            lfo->setShape(shape);
+            lfo->setControlRate(controlRate);
+
+            const Params params = {
+                { "sample_rate", std::to_string(static_cast<int>(sampleRate)) },
+                { "shape", lfoShapeName(shape) },
+                { "rate", controlRate ? "control" : "audio" }
+            };
+
+            runner.run("lfo/renderBlock", params, componentSamples, [=]
+            {
+                for (long i = 0; i < componentSamples; i += blockSize)
+                    lfo->renderBlock(output->data(), blockSize, 5.0f);
+                sink = (*output)[0];
+            });
+        }
+    }
+}
+
+void benchDucking(Runner& runner, float sampleRate)
+{
+    constexpr int blockSize = 256;
+    auto input = std::make_shared<std::vector<float>>(makeNoise(componentSamples, 0.5f, 3));
+    auto gains = std::make_shared<std::vector<float>>(componentSamples);
+
+    auto ducker = std::make_shared<DuckingEnvelope>();
+    ducker->prepare(sampleRate);
+
+    const Params params = { { "sample_rate", std::to_string(static_cast<int>(sampleRate)) } };
+
+    runner.run("ducking/process", params, componentSamples, [=]
+    {
+        float acc = 0.0f;
+        for (long i = 0; i < componentSamples; ++i)
+        {
+            ducker->process((*input)[static_cast<size_t>(i)]);
+            acc += ducker->applyDucking(1.0f, 0.5f);
+        }
+        sink = acc;
+    });
+
+    runner.run("ducking/processBlock", params, componentSamples, [=]
+    {
+        for (long i = 0; i < componentSamples; i += blockSize)
+            ducker->processBlock(input->data() + i, gains->data() + i, blockSize, 0.5f);
+        sink = (*gains)[0];
+    });
+}
+
+// === Engine ===
+
+struct EngineCase
+{
+    float sampleRate = 48000.0f;
+    int blockSize = 256;
+    StereoMode stereoMode = StereoMode::Stereo;
+    bool freeze = false;
+    bool ducking = false;
+};
+
+void benchEngine(Runner& runner, const EngineCase& c)
+{
+    // Half a second of audio per pass
+    const long frames = static_cast<long>(c.sampleRate * 0.5f);
+
+    auto engine = std::make_shared<DelayEngine>();
+    engine->prepare(c.sampleRate, c.blockSize);
+
+    DelayEngine::Parameters p;
+    p.delayTimeMs = 350.0f;
+    p.delayTimeRightMs = 420.0f;
+    p.feedback = 0.5f;
+    p.mix = 0.4f;
+    p.modDepth = 0.2f;
+    p.modRateHz = 0.8f;
+    p.lfoControlRate = true;
+    p.filterFreq = 6000.0f;
+    p.filterRes = 0.2f;
+    p.damping = 0.3f;
+    p.stereoMode = c.stereoMode;
+    p.duckingEnabled = c.ducking;
+    engine->setParameters(p);
+    engine->serviceDelayMemory();
+
+    const auto left = makeNoise(static_cast<size_t>(frames), 0.5f, 4);
+    const auto right = makeNoise(static_cast<size_t>(frames), 0.5f, 5);
+    auto workLeft = std::make_shared<std::vector<float>>(left);
+    auto workRight = std::make_shared<std::vector<float>>(right);
+
+    // Fill the line before freezing so the loop has something to hold
+    auto prime = [=](long count)
+    {
+        for (long pos = 0; pos < count; pos += c.blockSize)
+        {
+            int n = static_cast<int>(std::min<long>(c.blockSize, count - pos));
+            engine->process(workLeft->data() + pos, workRight->data() + pos, n);
+        }
+        engine->serviceDelayMemory();
+    };
+
+    prime(frames);
+    if (c.freeze)
+    {
+        p.freeze = true;
+        engine->setParameters(p);
+    }
+
+    const Params params = {
+        { "sample_rate", std::to_string(static_cast<int>(c.sampleRate)) },
+        { "block", std::to_string(c.blockSize) },
+        { "stereo", stereoModeName(c.stereoMode) },
+        { "freeze", c.freeze ? "on" : "off" },
+        { "ducking", c.ducking ? "on" : "off" }
+    };
+
+    runner.run("engine/process", params, frames,
+               [=] { prime(frames); sink = (*workLeft)[0]; },
+               [=] { *workLeft = left; *workRight = right; });
+}
+
+std::string jsonEscape(const std::string& text)
+{
+    std::string escaped;
+    for (char ch : text)
+    {
+        if (ch == '"' || ch == '\\')
+            escaped += '\\';
+        escaped += ch;
+    }
+    return escaped;
+}
+
+std::string toJson(const Runner& runner)
+{
+    std::ostringstream json;
+    json.precision(6);
+
+    json << "{\n  \"benchmark\": \"chronos_bench\",\n  \"version\": 1,\n";
+#if defined(__VERSION__)
+    json << "  \"compiler\": \"" << jsonEscape(__VERSION__) << "\",\n";
+#endif
+    json << "  \"unit\": \"ns per sample frame\",\n  \"results\": [\n";
+
+    for (size_t i = 0; i < runner.results.size(); ++i)
+    {
+        const auto& r = runner.results[i];
+        json << "    { \"name\": \"" << jsonEscape(r.name) << "\", \"params\": {";
+        for (size_t k = 0; k < r.params.size(); ++k)
+            json << (k == 0 ? " " : ", ") << "\"" << r.params[k].first << "\": \"" << jsonEscape(r.params[k].second) << "\"";
+        json << " }, \"ns_per_sample\": " << r.nsPerSample
+             << ", \"min_ns_per_sample\": " << r.minNsPerSample
+             << ", \"samples_per_sec\": " << 1e9 / r.nsPerSample
+             << ", \"passes\": " << r.passes << " }"
+             << (i + 1 < runner.results.size() ? "," : "") << "\n";
+    }
+
+    json << "  ]\n}\n";
+    return json.str();
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+#if defined(__SSE__) || defined(_M_X64)
+    // Flush denormals, as a host's audio thread would
+    _mm_setcsr(_mm_getcsr() | 0x8040);
+#endif
+
+    Runner runner;
+    std::string outPath;
+    bool full = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string { return i + 1 < argc ? argv[++i] : ""; };
+
+        if (arg == "--out")
+            outPath = value();
+        else if (arg == "--filter")
+            runner.filter = value();
+        else if (arg == "--min-time")
+            runner.minTime = std::max(0.01, std::atof(value().c_str()));
+        else if (arg == "--full")
+            full = true;
+        else
+        {
+            std::cerr << "Usage: chronos_bench [--out results.json] [--filter text] [--min-time seconds] [--full]\n";
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    const float sampleRates[] = { 44100.0f, 48000.0f, 96000.0f, 192000.0f };
+    const int blockSizes[] = { 1, 16, 64, 256, 1024, 4096 };
+    const StereoMode stereoModes[] = { StereoMode::Mono, StereoMode::Stereo, StereoMode::PingPong, StereoMode::Wide };
+
+    for (float sampleRate : sampleRates)
+    {
+        benchDelayLine(runner, sampleRate);
+        benchFeedbackProcessor(runner, sampleRate);
+        benchLFO(runner, sampleRate);
+        benchDucking(runner, sampleRate);
+    }
+
+    // Rate x block at the default settings, then modes x freeze x ducking at
+    // two block sizes; --full runs the whole cross product
+    std::vector<EngineCase> cases;
+    for (float sampleRate : sampleRates)
+        for (int blockSize : blockSizes)
+            for (auto mode : stereoModes)
+                for (bool freeze : { false, true })
+                    for (bool ducking : { false, true })
+                    {
+                        bool defaults = mode == StereoMode::Stereo && !freeze && !ducking;
+                        bool featureSweep = sampleRate == 48000.0f && (blockSize == 64 || blockSize == 1024);
+
+                        if (full || defaults || featureSweep)
+                            cases.push_back({ sampleRate, blockSize, mode, freeze, ducking });
+                    }
+
+    for (const auto& c : cases)
+        benchEngine(runner, c);
+
+    const std::string json = toJson(runner);
+    if (outPath.empty())
+    {
+        std::cout << json;
+    }
+    else
+    {
+        std::ofstream file(outPath);
+        file << json;
+        if (!file)
+        {
+            std::cerr << "chronos_bench: cannot write " << outPath << "\n";
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,247 @@
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "PresetHost.h"
+#include "RenderJob.h"
+#include "SegmentedRender.h"
+#include <iostream>
+
+namespace {
+
+const char* const usage =
+    "Usage: chronos_render [options] <input> <output>\n"
+    "       chronos_render [options] --jobs <list>\n"
+    "\n"
+    "Renders WAV/AIFF files through the Chronos delay engine.\n"
+    "\n"
+    "Options:\n"
+    "  --preset <file>   APVTS XML state, or a file of id=value lines\n"
+    "  --set id=value    Parameter override, repeatable (e.g. --set feedback=60)\n"
+    "  --jobs <list>     One job per line: input output [preset] [id=value ...]\n"
+    "                    Paths are relative to the list; # starts a comment\n"
+    "  --bpm <bpm>       Tempo for synced times (default 120)\n"
+    "  --tail <seconds>  Render the echoes past the end of each input (default 0)\n"
+    "  --block <n>       Engine block size in samples (default 8192)\n"
+    "  --threads <n>     Worker threads (default: all cores)\n"
+    "\n"
+    "Long files:\n"
+    "  --segmented       Render each file as parallel segments, one file at a time\n"
+    "  --segment <s>     Segment length in seconds (default 30, at least 4x the pre-roll)\n"
+    "  --threshold <dB>  Residual feedback allowed at a segment start (default -120)\n"
+    "  --crossfade <ms>  Blend across each seam (default 5)\n"
+    "  --verify          Also render serially and report the peak deviation\n";
+
+// A job as given on the command line, before its preset is resolved
+struct JobSpec
+{
+    juce::File input;
+    juce::File output;
+    juce::File preset;
+    juce::StringArray overrides;
+};
+
+juce::Result parseJobList(const juce::File& list, const JobSpec& defaults, std::vector<JobSpec>& specs)
+{
+    if (!list.existsAsFile())
+        return juce::Result::fail("job list not found: " + list.getFullPathName());
+
+    const auto dir = list.getParentDirectory();
+
+    juce::StringArray lines;
+    list.readLines(lines);
+
+    for (int i = 0; i < lines.size(); ++i)
+    {
+        auto line = lines[i].upToFirstOccurrenceOf("#", false, false).trim();
+        if (line.isEmpty())
+            continue;
+
+        juce::StringArray tokens;
+        tokens.addTokens(line, " \t", "\"");
+        tokens.removeEmptyStrings();
+
+        if (tokens.size() < 2)
+            return juce::Result::fail(list.getFileName() + ":" + juce::String(i + 1) + ": expected input and output");
+
+        JobSpec spec = defaults;
+        spec.input = dir.getChildFile(tokens[0].unquoted());
+        spec.output = dir.getChildFile(tokens[1].unquoted());
+
+        for (int t = 2; t < tokens.size(); ++t)
+        {
+            auto token = tokens[t].unquoted();
+            if (token.containsChar('='))
+                spec.overrides.add(token);
+            else
+                spec.preset = dir.getChildFile(token);
+        }
+
+        specs.push_back(spec);
+    }
+
+    return juce::Result::ok();
+}
+
+juce::String describe(const Chronos::SegmentReport& report)
+{
+    juce::String text = report.serialReason.isNotEmpty()
+                      ? "serial, " + report.serialReason
+                      : juce::String(report.numSegments) + " segments, " + juce::String(report.preRollSeconds, 1) + " s pre-roll";
+
+    if (report.maxDeviation == 0.0f)
+        text << ", identical to serial";
+    else if (report.maxDeviation > 0.0f)
+        text << ", max deviation " << juce::Decibels::toString(juce::Decibels::gainToDecibels(report.maxDeviation, -200.0f), 1)
+             << "FS from serial";
+
+    return text;
+}
+
+int fail(const juce::String& message)
+{
+    std::cerr << "chronos_render: " << message << std::endl;
+    return 1;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    // The APVTS expects a message thread
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    juce::ArgumentList args(argc, argv);
+
+    if (args.size() == 0 || args.containsOption("--help|-h"))
+    {
+        std::cout << usage;
+        return args.size() == 0 ? 1 : 0;
+    }
+
+    JobSpec defaults;
+    if (args.containsOption("--preset"))
+        defaults.preset = juce::File::getCurrentWorkingDirectory().getChildFile(args.removeValueForOption("--preset"));
+    while (args.containsOption("--set"))
+        defaults.overrides.add(args.removeValueForOption("--set"));
+
+    const juce::String jobList = args.containsOption("--jobs") ? args.removeValueForOption("--jobs") : juce::String();
+    const float bpm = args.containsOption("--bpm") ? args.removeValueForOption("--bpm").getFloatValue() : 120.0f;
+
+    Chronos::RenderSettings settings;
+    if (args.containsOption("--tail"))
+        settings.tailSeconds = std::max(0.0, args.removeValueForOption("--tail").getDoubleValue());
+    if (args.containsOption("--block"))
+        settings.blockSize = juce::jlimit(32, 1 << 16, args.removeValueForOption("--block").getIntValue());
+
+    const bool segmented = args.removeOptionIfFound("--segmented");
+    Chronos::SegmentSettings segmentSettings;
+    if (args.containsOption("--segment"))
+        segmentSettings.segmentSeconds = std::max(1.0, args.removeValueForOption("--segment").getDoubleValue());
+    if (args.containsOption("--threshold"))
+        segmentSettings.thresholdDb = std::min(-20.0f, args.removeValueForOption("--threshold").getFloatValue());
+    if (args.containsOption("--crossfade"))
+        segmentSettings.crossfadeMs = std::max(0.0, args.removeValueForOption("--crossfade").getDoubleValue());
+    segmentSettings.verify = args.removeOptionIfFound("--verify");
+
+    int numThreads = juce::SystemStats::getNumCpus();
+    if (args.containsOption("--threads"))
+        numThreads = std::max(1, args.removeValueForOption("--threads").getIntValue());
+
+    std::vector<JobSpec> specs;
+    if (jobList.isNotEmpty())
+    {
+        auto result = parseJobList(juce::File::getCurrentWorkingDirectory().getChildFile(jobList), defaults, specs);
+        if (result.failed())
+            return fail(result.getErrorMessage());
+    }
+
+    if (args.size() == 2)
+    {
+        JobSpec spec = defaults;
+        spec.input = args[0].resolveAsFile();
+        spec.output = args[1].resolveAsFile();
+        specs.push_back(spec);
+    }
+    else if (args.size() != 0)
+    {
+        return fail("unexpected arguments: " + args.arguments[0].text + "\n\n" + usage);
+    }
+
+    if (specs.empty())
+        return fail(juce::String("nothing to render\n\n") + usage);
+
+    // Presets resolve up front on this thread; workers only touch the DSP
+    std::vector<Chronos::RenderJob> jobs;
+    {
+        Chronos::PresetHost host;
+        for (const auto& spec : specs)
+        {
+            auto result = host.load(spec.preset, spec.overrides);
+            if (result.failed())
+                return fail(spec.input.getFileName() + ": " + result.getErrorMessage());
+
+            jobs.push_back({ spec.input, spec.output, host.getEngineParameters(bpm), host.getDelayStorage() });
+        }
+    }
+
+    // Whole files in parallel, or one file at a time split into segments
+    if (!segmented)
+        numThreads = std::min(numThreads, static_cast<int>(jobs.size()));
+
+    juce::ThreadPool pool(numThreads);
+    juce::CriticalSection logLock;
+    std::atomic<int> failures { 0 };
+
+    auto report = [&](const Chronos::RenderJob& job, const juce::Result& result, double jobStart, const juce::String& detail)
+    {
+        const auto seconds = (juce::Time::getMillisecondCounterHiRes() - jobStart) / 1000.0;
+        const juce::ScopedLock lock(logLock);
+
+        if (result.failed())
+        {
+            ++failures;
+            std::cerr << "FAILED " << job.input.getFileName() << ": " << result.getErrorMessage() << std::endl;
+            return;
+        }
+
+        std::cout << job.input.getFileName() << " -> " << job.output.getFullPathName()
+                  << " (" << juce::String(seconds, 2) << " s" << (detail.isNotEmpty() ? ", " + detail : juce::String()) << ")"
+                  << std::endl;
+    };
+
+    const auto start = juce::Time::getMillisecondCounterHiRes();
+
+    if (segmented)
+    {
+        for (const auto& job : jobs)
+        {
+            const auto jobStart = juce::Time::getMillisecondCounterHiRes();
+            Chronos::SegmentReport segmentReport;
+            const auto result = Chronos::renderFileSegmented(job, settings, segmentSettings, pool, segmentReport);
+            report(job, result, jobStart, describe(segmentReport));
+        }
+    }
+    else
+    {
+        juce::WaitableEvent finished;
+        std::atomic<int> remaining { static_cast<int>(jobs.size()) };
+
+        for (const auto& job : jobs)
+        {
+            pool.addJob([&]
+            {
+                const auto jobStart = juce::Time::getMillisecondCounterHiRes();
+                report(job, Chronos::renderFile(job, settings), jobStart, {});
+
+                if (--remaining == 0)
+                    finished.signal();
+            });
+        }
+
+        finished.wait();
+    }
+
+    std::cout << "Rendered " << (jobs.size() - static_cast<size_t>(failures.load())) << " of " << jobs.size()
+              << " files on " << numThreads << " threads in "
+              << juce::String((juce::Time::getMillisecondCounterHiRes() - start) / 1000.0, 2) << " s" << std::endl;
+
+    return failures > 0 ? 1 : 0;
+}
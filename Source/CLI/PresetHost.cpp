@@ -0,0 +1,77 @@
+#include "PresetHost.h"
+
+namespace Chronos {
+
+PresetHost::PresetHost()
+    : apvts(*this, nullptr, "Parameters", Parameters::createLayout()),
+      params(apvts)
+{
+}
+
+juce::Result PresetHost::load(const juce::File& preset, const juce::StringArray& overrides)
+{
+    for (auto* param : AudioProcessor::getParameters())
+        param->setValueNotifyingHost(param->getDefaultValue());
+
+    if (preset != juce::File())
+    {
+        if (!preset.existsAsFile())
+            return juce::Result::fail("preset not found: " + preset.getFullPathName());
+
+        // Same XML the plugin stores in its state
+        if (auto xml = juce::parseXML(preset))
+        {
+            if (!xml->hasTagName(apvts.state.getType()))
+                return juce::Result::fail("not a Chronos preset: " + preset.getFullPathName());
+
+            apvts.replaceState(juce::ValueTree::fromXml(*xml));
+        }
+        else
+        {
+            juce::StringArray lines;
+            preset.readLines(lines);
+
+            for (const auto& line : lines)
+            {
+                auto assignment = line.upToFirstOccurrenceOf("#", false, false).trim();
+                if (assignment.isEmpty())
+                    continue;
+
+                auto result = applyValue(assignment);
+                if (result.failed())
+                    return juce::Result::fail(preset.getFileName() + ": " + result.getErrorMessage());
+            }
+        }
+    }
+
+    for (const auto& assignment : overrides)
+    {
+        auto result = applyValue(assignment);
+        if (result.failed())
+            return result;
+    }
+
+    return juce::Result::ok();
+}
+
+juce::Result PresetHost::applyValue(const juce::String& assignment)
+{
+    auto id = assignment.upToFirstOccurrenceOf("=", false, false).trim();
+    auto text = assignment.fromFirstOccurrenceOf("=", false, false).trim();
+
+    if (id.isEmpty() || text.isEmpty())
+        return juce::Result::fail("expected id=value, got '" + assignment + "'");
+
+    auto* param = apvts.getParameter(id);
+    if (param == nullptr)
+        return juce::Result::fail("unknown parameter '" + id + "'");
+
+    // Numbers are plain values; anything else goes through the parameter's
+    // own text parser (choice names, on/off)
+    const bool numeric = text.containsOnly("0123456789.-+");
+    param->setValueNotifyingHost(numeric ? param->convertTo0to1(text.getFloatValue())
+                                         : param->getValueForText(text));
+    return juce::Result::ok();
+}
+
+} // namespace Chronos
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "../Utils/Parameters.h"
+
+namespace Chronos {
+
+// Headless processor that owns the plugin's APVTS, so presets resolve to
+// engine settings exactly as they do inside a host. It never plays audio.
+class PresetHost : public juce::AudioProcessor
+{
+public:
+    PresetHost();
+
+    // Defaults, then the preset file (APVTS XML or id=value lines), then the
+    // id=value overrides. Values are in the parameter's units (ms, %, dB);
+    // choices take an index or a name.
+    juce::Result load(const juce::File& preset, const juce::StringArray& overrides);
+
+    DelayEngine::Parameters getEngineParameters(float bpm) const { return params.makeEngineParameters(bpm, true); }
+    DelayStorage getDelayStorage() const { return params.getDelayStorage(); }
+
+    // AudioProcessor
+    const juce::String getName() const override { return "Chronos Render"; }
+    void prepareToPlay(double, int) override {}
+    void releaseResources() override {}
+    void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override {}
+    double getTailLengthSeconds() const override { return 0.0; }
+    bool acceptsMidi() const override { return false; }
+    bool producesMidi() const override { return false; }
+    juce::AudioProcessorEditor* createEditor() override { return nullptr; }
+    bool hasEditor() const override { return false; }
+    int getNumPrograms() override { return 1; }
+    int getCurrentProgram() override { return 0; }
+    void setCurrentProgram(int) override {}
+    const juce::String getProgramName(int) override { return {}; }
+    void changeProgramName(int, const juce::String&) override {}
+    void getStateInformation(juce::MemoryBlock&) override {}
+    void setStateInformation(const void*, int) override {}
+
+private:
+    juce::Result applyValue(const juce::String& assignment);
+
+    juce::AudioProcessorValueTreeState apvts;
+    Parameters params;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetHost)
+};
+
+} // namespace Chronos
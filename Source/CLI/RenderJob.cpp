@@ -0,0 +1,127 @@
+#include "RenderJob.h"
+
+namespace Chronos {
+
+std::unique_ptr<juce::AudioFormatReader> openReader(const juce::File& file)
+{
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+    return std::unique_ptr<juce::AudioFormatReader>(formats.createReaderFor(file));
+}
+
+juce::Result openRenderFiles(const RenderJob& job, const RenderSettings& settings, RenderFiles& files)
+{
+    // Checked before anything is opened: the render streams from the input
+    // while the output is written
+    if (job.output.getLinkedTarget() == job.input.getLinkedTarget())
+        return juce::Result::fail("output would overwrite the input: " + job.output.getFullPathName());
+
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    files.reader.reset(formats.createReaderFor(job.input));
+    if (files.reader == nullptr)
+        return juce::Result::fail("cannot read " + job.input.getFullPathName());
+
+    auto& reader = *files.reader;
+    const int numChannels = static_cast<int>(reader.numChannels);
+    if (numChannels < 1 || numChannels > DelayEngine::maxChannels)
+        return juce::Result::fail(job.input.getFileName() + ": unsupported channel count " + juce::String(numChannels));
+
+    auto* format = formats.findFormatForFileExtension(job.output.getFileExtension());
+    if (format == nullptr)
+        return juce::Result::fail("unsupported output format: " + job.output.getFileName());
+
+    int bitDepth = reader.usesFloatingPointData ? 32 : static_cast<int>(reader.bitsPerSample);
+    if (!format->getPossibleBitDepths().contains(bitDepth))
+        bitDepth = 24;
+
+    // Same folder and extension as the output, so the final move is a rename
+    files.output = std::make_unique<juce::TemporaryFile>(job.output);
+    std::unique_ptr<juce::OutputStream> stream(files.output->getFile().createOutputStream());
+    if (stream == nullptr)
+        return juce::Result::fail("cannot write " + files.output->getFile().getFullPathName());
+
+    files.writer.reset(format->createWriterFor(stream.get(), reader.sampleRate, static_cast<unsigned int>(numChannels),
+                                               bitDepth, reader.metadataValues, 0));
+    if (files.writer == nullptr)
+        return juce::Result::fail(job.output.getFileName() + ": format cannot hold this audio");
+
+    stream.release();  // Owned by the writer
+
+    // WAV channel masks carry the speaker positions; otherwise no pairs
+    files.channels = reader.getChannelLayout();
+    if (files.channels.size() != numChannels)
+        files.channels = juce::AudioChannelSet::discreteChannels(numChannels);
+
+    files.length = reader.lengthInSamples + static_cast<juce::int64>(settings.tailSeconds * reader.sampleRate);
+    return juce::Result::ok();
+}
+
+juce::Result finishRenderFiles(const RenderJob& job, RenderFiles& files)
+{
+    // Flushes the header and closes the stream
+    files.writer.reset();
+
+    if (!files.output->overwriteTargetFileWithTemporary())
+        return juce::Result::fail("cannot replace " + job.output.getFullPathName());
+
+    return juce::Result::ok();
+}
+
+RenderStream::RenderStream(const RenderJob& job, const RenderSettings& settings, double sampleRate,
+                           const juce::AudioChannelSet& channels)
+    : engine(std::make_unique<DelayEngine>()),
+      buffer(channels.size(), settings.blockSize)
+{
+    engine->prepare(static_cast<float>(sampleRate), settings.blockSize, job.storage, makeChannelLayout(channels, order));
+    engine->setParameters(job.params);
+
+    // Pages for the preset's delay time, before the first write
+    engine->serviceDelayMemory();
+
+    for (int ch = 0; ch < channels.size(); ++ch)
+        channelPointers[ch] = buffer.getWritePointer(order[static_cast<size_t>(ch)]);
+}
+
+const juce::AudioBuffer<float>& RenderStream::render(juce::AudioFormatReader& reader, juce::int64 pos, int numSamples)
+{
+    jassert(numSamples <= buffer.getNumSamples());
+
+    reader.read(&buffer, 0, numSamples, pos, true, true);
+    engine->process(channelPointers, numSamples);
+
+    // No timer commits pages in a headless render
+    engine->serviceDelayMemory();
+
+    return buffer;
+}
+
+juce::Result renderFile(const RenderJob& job, const RenderSettings& settings)
+{
+    RenderFiles files;
+    auto result = openRenderFiles(job, settings, files);
+    if (result.wasOk())
+        result = renderFile(job, settings, files);
+
+    return result.wasOk() ? finishRenderFiles(job, files) : result;
+}
+
+juce::Result renderFile(const RenderJob& job, const RenderSettings& settings, RenderFiles& files)
+{
+    juce::ScopedNoDenormals noDenormals;
+
+    RenderStream stream(job, settings, files.reader->sampleRate, files.channels);
+
+    for (juce::int64 pos = 0; pos < files.length; pos += settings.blockSize)
+    {
+        const int n = static_cast<int>(std::min<juce::int64>(settings.blockSize, files.length - pos));
+
+        if (!files.writer->writeFromAudioSampleBuffer(stream.render(*files.reader, pos, n), 0, n))
+            return juce::Result::fail("write failed: " + job.output.getFullPathName());
+    }
+
+    return juce::Result::ok();
+}
+
+} // namespace Chronos
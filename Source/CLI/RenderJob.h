@@ -0,0 +1,71 @@
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include "../DSP/DelayEngine.h"
+#include "../Utils/ChannelMapping.h"
+
+namespace Chronos {
+
+// One file to render, with its preset already resolved to engine settings
+struct RenderJob
+{
+    juce::File input;
+    juce::File output;
+    DelayEngine::Parameters params;
+    DelayStorage storage = DelayStorage::Float32;
+};
+
+struct RenderSettings
+{
+    int blockSize = 8192;       // Engine block size; offline there is no reason to go small
+    double tailSeconds = 0.0;   // Silence rendered past the end of the input
+};
+
+// The job's input and an output writer matching its rate, channel count and
+// bit depth. The writer fills a temporary file beside the output, which only
+// replaces it in finishRenderFiles(); a failed render leaves the output as
+// it was.
+struct RenderFiles
+{
+    std::unique_ptr<juce::AudioFormatReader> reader;
+    std::unique_ptr<juce::TemporaryFile> output;    // Deleted unless finished; outlives the writer
+    std::unique_ptr<juce::AudioFormatWriter> writer;
+    juce::AudioChannelSet channels;
+    juce::int64 length = 0;     // Input plus tail, in samples
+};
+
+std::unique_ptr<juce::AudioFormatReader> openReader(const juce::File& file);
+juce::Result openRenderFiles(const RenderJob& job, const RenderSettings& settings, RenderFiles& files);
+
+// Closes the writer and moves the finished file over the job's output
+juce::Result finishRenderFiles(const RenderJob& job, RenderFiles& files);
+
+// One engine running over a reader, a block at a time
+class RenderStream
+{
+public:
+    RenderStream(const RenderJob& job, const RenderSettings& settings, double sampleRate,
+                 const juce::AudioChannelSet& channels);
+
+    // Reads numSamples from pos (silence past the end of the input) and
+    // returns them processed, in buffer channel order
+    const juce::AudioBuffer<float>& render(juce::AudioFormatReader& reader, juce::int64 pos, int numSamples);
+
+    DelayEngine& getEngine() { return *engine; }
+
+private:
+    std::unique_ptr<DelayEngine> engine;
+    juce::AudioBuffer<float> buffer;
+    ChannelOrder order {};
+    float* channelPointers[DelayEngine::maxChannels] {};
+};
+
+// Streams the input through its own DelayEngine into the output file.
+// Safe to run concurrently.
+juce::Result renderFile(const RenderJob& job, const RenderSettings& settings);
+
+// The streaming part alone, into files' writer; finishRenderFiles() is left
+// to the caller
+juce::Result renderFile(const RenderJob& job, const RenderSettings& settings, RenderFiles& files);
+
+} // namespace Chronos
@@ -0,0 +1,235 @@
+#include "SegmentedRender.h"
+
+namespace Chronos {
+
+namespace {
+
+// In-flight segment audio is capped at this, whatever the thread count
+constexpr double maxBufferedBytes = 1024.0 * 1024.0 * 1024.0;
+
+struct Segment
+{
+    juce::int64 start = 0;          // Output range [start, end)
+    juce::int64 end = 0;
+    juce::int64 warmStart = 0;      // Engine starts here, pre-roll earlier
+    int fadeOut = 0;                // Extra samples past end, blended into the next segment
+    float lfoPhase = 0.0f;          // Serial render's LFO phase at warmStart
+
+    juce::AudioBuffer<float> output;
+    juce::Result result = juce::Result::ok();
+    juce::WaitableEvent done { true };  // Waited on again at cleanup
+};
+
+void renderSegment(const RenderJob& job, const RenderSettings& settings, const RenderFiles& files, Segment& segment)
+{
+    juce::ScopedNoDenormals noDenormals;
+
+    // Readers are not shared between threads
+    auto reader = openReader(job.input);
+    if (reader == nullptr)
+    {
+        segment.result = juce::Result::fail("cannot read " + job.input.getFullPathName());
+        return;
+    }
+
+    RenderStream stream(job, settings, files.reader->sampleRate, files.channels);
+    stream.getEngine().setLFOPhase(segment.lfoPhase);
+
+    const auto outputEnd = segment.end + segment.fadeOut;
+    segment.output.setSize(files.channels.size(), static_cast<int>(outputEnd - segment.start));
+
+    for (auto pos = segment.warmStart; pos < outputEnd; pos += settings.blockSize)
+    {
+        const int n = static_cast<int>(std::min<juce::int64>(settings.blockSize, outputEnd - pos));
+        const auto& block = stream.render(*reader, pos, n);
+
+        // Keep what lands at or past the segment start
+        const int skip = static_cast<int>(juce::jlimit<juce::int64>(0, n, segment.start - pos));
+        if (skip == n)
+            continue;
+
+        for (int ch = 0; ch < block.getNumChannels(); ++ch)
+            segment.output.copyFrom(ch, static_cast<int>(pos + skip - segment.start), block, ch, skip, n - skip);
+    }
+}
+
+} // namespace
+
+juce::Result renderFileSegmented(const RenderJob& job, const RenderSettings& settings,
+                                 const SegmentSettings& segmentSettings, juce::ThreadPool& pool,
+                                 SegmentReport& report)
+{
+    juce::ScopedNoDenormals noDenormals;
+    report = {};
+
+    RenderFiles files;
+    auto result = openRenderFiles(job, settings, files);
+    if (result.failed())
+        return result;
+
+    const double sampleRate = files.reader->sampleRate;
+    const int numChannels = files.channels.size();
+    const auto& params = job.params;
+
+    // Random LFO draws cannot be replayed from a mid-file start
+    const bool randomLFO = params.modDepth > 0.0f
+                        && (params.lfoShape == LFOShape::Random || params.lfoShape == LFOShape::SmoothRandom);
+
+    report.preRollSeconds = randomLFO ? -1.0 : estimateDecaySeconds(params, segmentSettings.thresholdDb);
+
+    const auto preRoll = static_cast<juce::int64>(std::ceil(std::max(report.preRollSeconds, 0.0) * sampleRate));
+    const auto segmentLength = std::max({ static_cast<juce::int64>(segmentSettings.segmentSeconds * sampleRate),
+                                          4 * preRoll, static_cast<juce::int64>(settings.blockSize) });
+
+    if (randomLFO)
+        report.serialReason = "random LFO shape";
+    else if (report.preRollSeconds < 0.0)
+        report.serialReason = "feedback does not decay";
+    else if (files.length < 2 * segmentLength || segmentLength > std::numeric_limits<int>::max() / 2)
+        report.serialReason = "too short for the pre-roll";
+
+    if (report.serialReason.isNotEmpty())
+    {
+        result = renderFile(job, settings, files);
+        if (result.wasOk())
+            result = finishRenderFiles(job, files);
+
+        report.maxDeviation = segmentSettings.verify && result.wasOk() ? 0.0f : -1.0f;
+        return result;
+    }
+
+    // Segments, and the serial render's LFO phase at each warm-up start
+    // (stepped the way the engine steps it, so the rounding matches)
+    const auto crossfade = std::min(static_cast<juce::int64>(segmentSettings.crossfadeMs * sampleRate / 1000.0),
+                                    segmentLength / 2);
+    const float phaseIncrement = params.modRateHz / static_cast<float>(sampleRate);
+
+    std::vector<std::unique_ptr<Segment>> segments;
+    float phase = 0.0f;
+    juce::int64 phasePos = 0;
+
+    for (juce::int64 start = 0; start < files.length; start += segmentLength)
+    {
+        auto segment = std::make_unique<Segment>();
+        segment->start = start;
+        segment->end = std::min(files.length, start + segmentLength);
+        segment->warmStart = std::max<juce::int64>(0, start - preRoll);
+
+        phase = ModulationLFO::skipPhase(phase, phaseIncrement, segment->warmStart - phasePos);
+        phasePos = segment->warmStart;
+        segment->lfoPhase = phase;
+
+        segments.push_back(std::move(segment));
+    }
+
+    for (size_t i = 0; i + 1 < segments.size(); ++i)
+        segments[i]->fadeOut = static_cast<int>(std::min(crossfade, segments[i + 1]->end - segments[i + 1]->start));
+
+    report.numSegments = static_cast<int>(segments.size());
+
+    // Bounded window of segments in flight; they are written in order
+    const double segmentBytes = static_cast<double>(segmentLength + crossfade) * numChannels * sizeof(float);
+    const int window = juce::jlimit(2, std::max(2, 2 * pool.getNumThreads()),
+                                    static_cast<int>(maxBufferedBytes / segmentBytes));
+    size_t submitted = 0;
+
+    auto submitNext = [&]
+    {
+        if (submitted == segments.size())
+            return;
+
+        auto* segment = segments[submitted++].get();
+        pool.addJob([&job, &settings, &files, segment]
+        {
+            renderSegment(job, settings, files, *segment);
+            segment->done.signal();
+        });
+    };
+
+    for (int i = 0; i < window; ++i)
+        submitNext();
+
+    // Optional serial reference, rendered alongside on this thread
+    std::unique_ptr<juce::AudioFormatReader> referenceReader;
+    std::unique_ptr<RenderStream> reference;
+    if (segmentSettings.verify)
+    {
+        referenceReader = openReader(job.input);
+        reference = std::make_unique<RenderStream>(job, settings, sampleRate, files.channels);
+    }
+
+    juce::AudioBuffer<float> overlap(numChannels, static_cast<int>(std::max<juce::int64>(crossfade, 1)));
+    int overlapLength = 0;
+    float maxDeviation = 0.0f;
+
+    for (auto& segmentPtr : segments)
+    {
+        auto& segment = *segmentPtr;
+        segment.done.wait();
+
+        if (segment.result.failed())
+        {
+            result = segment.result;
+            break;
+        }
+
+        auto& output = segment.output;
+        const int length = static_cast<int>(segment.end - segment.start);
+
+        // Seam: the previous segment's overrun fades out as this one fades in
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            float* out = output.getWritePointer(ch);
+            const float* prev = overlap.getReadPointer(ch);
+            for (int i = 0; i < overlapLength; ++i)
+            {
+                const float fade = (static_cast<float>(i) + 0.5f) / static_cast<float>(overlapLength);
+                out[i] = prev[i] + (out[i] - prev[i]) * fade;
+            }
+        }
+
+        if (reference != nullptr)
+        {
+            for (int pos = 0; pos < length; pos += settings.blockSize)
+            {
+                const int n = std::min(settings.blockSize, length - pos);
+                const auto& serial = reference->render(*referenceReader, segment.start + pos, n);
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                {
+                    const float* a = output.getReadPointer(ch, pos);
+                    const float* b = serial.getReadPointer(ch);
+                    for (int i = 0; i < n; ++i)
+                        maxDeviation = std::max(maxDeviation, std::abs(a[i] - b[i]));
+                }
+            }
+        }
+
+        if (!files.writer->writeFromAudioSampleBuffer(output, 0, length))
+        {
+            result = juce::Result::fail("write failed: " + job.output.getFullPathName());
+            break;
+        }
+
+        overlapLength = segment.fadeOut;
+        for (int ch = 0; ch < numChannels; ++ch)
+            overlap.copyFrom(ch, 0, output, ch, length, overlapLength);
+
+        output.setSize(0, 0);
+        submitNext();
+    }
+
+    // Segments still running reference this frame
+    for (size_t i = 0; i < submitted; ++i)
+        segments[i]->done.wait();
+
+    if (result.wasOk())
+        result = finishRenderFiles(job, files);
+
+    if (result.wasOk() && segmentSettings.verify)
+        report.maxDeviation = maxDeviation;
+
+    return result;
+}
+
+} // namespace Chronos
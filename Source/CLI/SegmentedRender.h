@@ -0,0 +1,34 @@
+#pragma once
+
+#include "RenderJob.h"
+#include "../DSP/DecayEstimate.h"
+
+namespace Chronos {
+
+// One long file rendered as segments in parallel. Each segment's engine
+// starts a pre-roll early on the real input, long enough for whatever the
+// serial render would still be carrying (delay history, feedback tail,
+// ducking envelope) to fall below thresholdDb; seams are crossfaded.
+struct SegmentSettings
+{
+    double segmentSeconds = 30.0;   // Output per segment (at least 4x the pre-roll)
+    float thresholdDb = -120.0f;    // Residual state allowed at a segment start
+    double crossfadeMs = 5.0;       // Blend across each seam
+    bool verify = false;            // Also render serially and compare
+};
+
+struct SegmentReport
+{
+    int numSegments = 1;
+    double preRollSeconds = 0.0;
+    juce::String serialReason;      // Why it fell back to a serial render, if it did
+    float maxDeviation = -1.0f;     // Peak |segmented - serial|; -1 if not verified
+};
+
+// Renders the job with its segments spread over the pool; falls back to a
+// serial render when the settings leave nothing to split
+juce::Result renderFileSegmented(const RenderJob& job, const RenderSettings& settings,
+                                 const SegmentSettings& segmentSettings, juce::ThreadPool& pool,
+                                 SegmentReport& report);
+
+} // namespace Chronos
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include <algorithm>
+
+namespace Chronos {
+
+// 64-byte aligned, zero-initialised blocks for DSP buffers.
+//
+// Memory comes from calloc, which for large requests maps fresh pages that
+// the OS zero-fills on first touch, so nothing is memset up front and
+// creating many instances stays cheap. prefault() touches every page ahead
+// of time so the audio thread never takes the first-touch fault.
+namespace AlignedMemory {
+
+static constexpr size_t alignment = 64;
+static constexpr size_t osPageBytes = 4096;
+
+// Zeroed block of at least bytes, aligned to 64; free with release().
+// Throws std::bad_alloc on failure, like the vectors these blocks replace.
+inline void* allocate(size_t bytes)
+{
+    // Room to align, plus the original pointer stored just below the block
+    if (bytes > SIZE_MAX - alignment - sizeof(void*))
+        throw std::bad_alloc();
+
+    void* raw = std::calloc(bytes + alignment + sizeof(void*), 1);
+    if (raw == nullptr)
+        throw std::bad_alloc();
+
+    auto base = reinterpret_cast<uintptr_t>(raw) + sizeof(void*);
+    auto aligned = (base + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+    reinterpret_cast<void**>(aligned)[-1] = raw;
+    return reinterpret_cast<void*>(aligned);
+}
+
+inline void release(void* block)
+{
+    if (block != nullptr)
+        std::free(static_cast<void**>(block)[-1]);
+}
+
+// Writes one byte per OS page (the memory is zero, so this stores zero)
+inline void prefault(void* block, size_t bytes)
+{
+    auto* bytesPtr = static_cast<volatile unsigned char*>(block);
+    for (size_t i = 0; i < bytes; i += osPageBytes)
+        bytesPtr[i] = 0;
+    if (bytes > 0)
+        bytesPtr[bytes - 1] = 0;
+}
+
+} // namespace AlignedMemory
+
+// Per-instance bump allocator for buffers sized in prepare(): one engine's
+// scratch, ramps and oversampling buffers share a few contiguous chunks
+// instead of a vector each. Blocks live until release(); arrays handed out
+// are aligned to 64 bytes (a cache line, and any SIMD width) and zeroed.
+// allocate() never returns nullptr: it throws std::bad_alloc, so a failed
+// prepare() fails loudly instead of leaving null buffers for the audio
+// thread.
+class BufferArena
+{
+public:
+    static constexpr size_t chunkBytes = 256 * 1024;
+
+    BufferArena() = default;
+    ~BufferArena() { release(); }
+
+    BufferArena(const BufferArena&) = delete;
+    BufferArena& operator=(const BufferArena&) = delete;
+
+    // Frees every chunk; previously returned arrays become invalid
+    void release()
+    {
+        for (auto& chunk : chunks)
+            AlignedMemory::release(chunk.data);
+
+        chunks.clear();
+    }
+
+    template <typename T>
+    T* allocate(size_t count)
+    {
+        static_assert(std::is_trivially_default_constructible_v<T>, "arena memory is not constructed");
+        static_assert(alignof(T) <= AlignedMemory::alignment, "over-aligned type");
+
+        size_t bytes = roundUp(std::max<size_t>(count, 1) * sizeof(T));
+
+        if (chunks.empty() || chunks.back().used + bytes > chunks.back().size)
+        {
+            // Room for the entry first, so push_back cannot throw and leak the chunk
+            chunks.reserve(chunks.size() + 1);
+
+            size_t size = std::max(chunkBytes, bytes);
+            void* data = AlignedMemory::allocate(size);
+            chunks.push_back({ static_cast<unsigned char*>(data), size, 0 });
+        }
+
+        auto& chunk = chunks.back();
+        T* block = reinterpret_cast<T*>(chunk.data + chunk.used);
+        chunk.used += bytes;
+        return block;
+    }
+
+    // Touches the used part of every chunk. Call from prepare(), off the
+    // audio thread.
+    void prefault()
+    {
+        for (auto& chunk : chunks)
+            AlignedMemory::prefault(chunk.data, chunk.used);
+    }
+
+    size_t getBytesUsed() const
+    {
+        size_t total = 0;
+        for (auto& chunk : chunks)
+            total += chunk.used;
+        return total;
+    }
+
+private:
+    struct Chunk
+    {
+        unsigned char* data = nullptr;
+        size_t size = 0;
+        size_t used = 0;
+    };
+
+    static size_t roundUp(size_t bytes)
+    {
+        return (bytes + AlignedMemory::alignment - 1) & ~(AlignedMemory::alignment - 1);
+    }
+
+    std::vector<Chunk> chunks;
+};
+
+} // namespace Chronos
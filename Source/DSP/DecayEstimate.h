@@ -0,0 +1,80 @@
+#pragma once
+
+#include "DelayEngine.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Chronos {
+
+// Seconds after the input stops (or, equally, of input before a point) for
+// everything the engine carries from earlier audio - delay history,
+// feedback tail, ducking envelope - to fall below thresholdDb. Negative
+// when the feedback need not decay: freeze, or a small-signal loop gain of
+// 1 or more. A conservative bound, not a measurement.
+inline double estimateDecaySeconds(const DelayEngine::Parameters& params, float thresholdDb)
+{
+    // Ducking release (DuckingEnvelope's default) and a floor for the
+    // smoothers, oversampler and DC state
+    constexpr double duckReleaseSeconds = 0.15;
+    constexpr double minSettleSeconds = 0.05;
+    constexpr double pi = 3.14159265358979323846;
+
+    if (params.freeze)
+        return -1.0;
+
+    // Longest read into the history, and the longest path round the loop
+    // with the total send into it
+    const float modMs = std::max(params.modDepth, 0.0f) * 20.0f;
+    float readMs = std::max(params.delayTimeMs, params.delayTimeRightMs);
+    float loopMs = readMs;
+    float sends = 1.0f;
+
+    if (params.multiTap)
+    {
+        loopMs = 0.0f;
+        sends = 0.0f;
+
+        for (int t = 0; t < std::min(params.numTaps, MAX_TAPS); ++t)
+        {
+            const auto& tap = params.taps[static_cast<size_t>(t)];
+            const float timeMs = std::clamp(tap.timeMs, 1.0f, MAX_DELAY_MS);
+
+            readMs = std::max(readMs, timeMs);
+            if (tap.feedback > 0.0f)
+            {
+                loopMs = std::max(loopMs, timeMs);
+                sends += tap.feedback;
+            }
+        }
+    }
+
+    readMs = std::min(readMs, MAX_DELAY_MS) + modMs;
+    loopMs = std::min(loopMs, MAX_DELAY_MS) + modMs;
+
+    // Small-signal loop gain bound: feedback, the filter's resonant peak
+    // (Q = 1 / (2 - 2 res)) and the saturation's slope at zero, 1 + 4 drive^2
+    const float k = 2.0f - 2.0f * std::clamp(params.filterRes, 0.0f, 1.0f);
+    if (k <= 0.0f)
+        return -1.0;
+
+    const double q = 1.0 / k;
+    const double filterPeak = q > std::sqrt(0.5) ? q / std::sqrt(1.0 - 1.0 / (4.0 * q * q)) : 1.0;
+    const double drive = std::clamp(params.drive, 0.0f, 1.0f);
+    const double loopGain = std::max(params.feedback, 0.0f) * sends * filterPeak * (1.0 + 4.0 * drive * drive);
+
+    if (loopGain >= 1.0)
+        return -1.0;
+
+    const double threshold = std::pow(10.0, static_cast<double>(thresholdDb) / 20.0);
+    const double decayTimes = std::log(1.0 / threshold);  // Time constants down to the threshold
+    const double passes = loopGain > 0.0 ? std::ceil(std::log(threshold) / std::log(loopGain)) : 0.0;
+
+    // The filter rings for 2Q / w per time constant on top of each pass
+    const double filterSettle = decayTimes * 2.0 * q / (2.0 * pi * std::clamp(params.filterFreq, 20.0f, 20000.0f));
+    const double duckSettle = params.duckingEnabled ? decayTimes * duckReleaseSeconds : 0.0;
+
+    return (readMs + passes * loopMs) / 1000.0
+         + std::max({ filterSettle, duckSettle, minSettleSeconds });
+}
+
+} // namespace Chronos
@@ -1,78 +1,157 @@
 #pragma once
 
-#include "DelayLine.h"
+#include "MultiChannelDelayLine.h"
 #include "ModulationLFO.h"
 #include "FeedbackProcessor.h"
 #include "DuckingEnvelope.h"
 #include "StereoProcessor.h"
+#include "ParameterSmoother.h"
+#include "Telemetry.h"
+#include "WaveformSummary.h"
 #include <array>
 #include <vector>
+#include <utility>
 #include <algorithm>
 
 namespace Chronos {
 
-static constexpr float MAX_DELAY_MS = 2000.0f;
-static constexpr int FREEZE_BUFFER_SIZE = 88200;  // 2 seconds at 44.1kHz
+static constexpr float MAX_DELAY_MS = 60000.0f;  // Paged: memory follows the delay in use
+static constexpr float FREEZE_CROSSFADE_MS = 10.0f;  // Freeze loop seam
+static constexpr int MAX_TAPS = 16;
 
+// Channel arrangement. Channels [0, 2 * numPairs) are left/right pairs, which
+// get the stereo mode, width, tap pan and the left/right delay times; the rest
+// are single channels (mono, centre, LFE) on the main delay time.
+struct ChannelLayout
+{
+    int numChannels = 2;
+    int numPairs = 1;
+
+    static ChannelLayout mono() { return { 1, 0 }; }
+    static ChannelLayout stereo() { return { 2, 1 }; }
+};
+
+// One tap of the multi-tap mode. Every tap reads the same delay line.
+struct DelayTap
+{
+    float timeMs = 250.0f;
+    float level = 1.0f;     // Linear gain
+    float pan = 0.0f;       // -1 (left) to 1 (right), as a balance control
+    float feedback = 0.0f;  // Send into the feedback chain
+};
+
+// Delay engine for any channel layout up to MultiChannelDelayLine::maxChannels.
+// Every per-channel state (feedback, filters, oversamplers, interpolator
+// state) is an array indexed by channel, block stages loop channel by channel
+// over contiguous arrays, and the delay line stores a frame's channels
+// side by side. A mono instance does mono work only.
 class DelayEngine
 {
 public:
+    static constexpr int maxChannels = MultiChannelDelayLine::maxChannels;
+
     DelayEngine() = default;
 
-    void prepare(float sampleRate, int samplesPerBlock)
+    void prepare(float sampleRate, int samplesPerBlock, DelayStorage storage = DelayStorage::Float32,
+                 ChannelLayout channelLayout = ChannelLayout::stereo())
     {
         this->sampleRate = sampleRate;
 
-        // Prepare delay lines
-        for (auto& delay : delayLines)
-            delay.prepare(sampleRate, MAX_DELAY_MS);
+        layout.numChannels = std::clamp(channelLayout.numChannels, 1, maxChannels);
+        layout.numPairs = std::clamp(channelLayout.numPairs, 0, layout.numChannels / 2);
+        numChannels = layout.numChannels;
+
+        // Block-sized buffers below share one aligned arena
+        arena.release();
+
+        // Scratch for the staged block path; larger host blocks are split
+        maxBlockSize = std::max(samplesPerBlock, 1);
+        for (auto& buf : scratch)
+            buf = arena.allocate<float>(static_cast<size_t>(maxBlockSize));
+        for (auto& buf : channelScratch)
+            buf = arena.allocate<float>(static_cast<size_t>(maxBlockSize) * static_cast<size_t>(numChannels));
+
+        // Per-sample parameter ramps; the first setParameters() snaps to target
+        smoother.prepare(sampleRate, maxBlockSize, smoothingTimesMs, arena);
+        for (auto& tap : tapSmoothers)
+        {
+            tap.time.prepare(sampleRate, smoothingTimesMs[DelayTime]);
+            tap.gainLeft.prepare(sampleRate, smoothingTimesMs[Mix]);
+            tap.gainRight.prepare(sampleRate, smoothingTimesMs[Mix]);
+            tap.gainCentre.prepare(sampleRate, smoothingTimesMs[Mix]);
+            tap.send.prepare(sampleRate, smoothingTimesMs[Feedback]);
+        }
+        snapSmoothers = true;
+
+        // Prepare delay line, with pages for the last known delay time
+        delayLine.prepare(sampleRate, MAX_DELAY_MS, numChannels, arena, storage);
+        updateRequiredDelay();
+        delayLine.servicePages();
+
+        // Per-channel state, carrying over the current settings
+        const size_t channels = static_cast<size_t>(numChannels);
+        feedbackProcessors.resize(channels);
+        limiterOversamplers.resize(channels);
+        feedbackSamples.assign(channels, 0.0f);
+        lastWetSamples.assign(channels, 0.0f);
+        thiranStates.assign(channels, {});
+        tapThiranStates.assign(channels * MAX_TAPS, {});
 
         // Prepare sub-processors
         lfo.prepare(sampleRate);
         for (auto& fb : feedbackProcessors)
-            fb.prepare(sampleRate);
-        ducker.prepare(sampleRate);
-
-        // Prepare freeze buffers
-        for (auto& buf : freezeBuffers)
         {
-            buf.resize(FREEZE_BUFFER_SIZE, 0.0f);
-            std::fill(buf.begin(), buf.end(), 0.0f);
+            fb.prepare(sampleRate, maxBlockSize, arena);
+            fb.setSaturationAccuracy(saturationAccuracy);
+            fb.setOversampling(oversampling);
         }
-        freezeReadPos = 0;
+        for (auto& os : limiterOversamplers)
+        {
+            os.prepare(maxBlockSize, arena);
+            os.setFactor(oversampling);
+        }
+        ducker.prepare(sampleRate);
+        if (telemetryEnabled)
+            waveform.prepare(sampleRate);
 
-        // Feedback state
-        feedbackSamples[0] = 0.0f;
-        feedbackSamples[1] = 0.0f;
+        // Fault the arena in here rather than on the first audio callback
+        arena.prefault();
+
+        // Coefficients depend on the sample rate; recomputed on the next update
+        feedbackCoeffs.prepare(sampleRate);
     }
 
     void reset()
     {
-        for (auto& delay : delayLines)
-            delay.clear();
+        delayLine.clear();
 
         lfo.reset();
         for (auto& fb : feedbackProcessors)
             fb.reset();
+        for (auto& os : limiterOversamplers)
+            os.reset();
         ducker.reset();
 
-        feedbackSamples[0] = 0.0f;
-        feedbackSamples[1] = 0.0f;
+        std::fill(feedbackSamples.begin(), feedbackSamples.end(), 0.0f);
+        waveform.reset();
 
-        for (auto& buf : freezeBuffers)
-            std::fill(buf.begin(), buf.end(), 0.0f);
+        snapSmoothers = true;
     }
 
+    const ChannelLayout& getChannelLayout() const { return layout; }
+
     struct Parameters
     {
         float delayTimeMs = 250.0f;
-        float delayTimeRightMs = 250.0f;  // For stereo offset
+        float delayTimeRightMs = 250.0f;  // Right channel of each pair
         float feedback = 0.3f;
         float mix = 0.5f;
 
         // Modulation
         float modRateHz = 0.5f;
         float modDepth = 0.0f;
+        LFOShape lfoShape = LFOShape::Sine;
+        bool lfoControlRate = false;  // Evaluate the LFO every 32 samples
 
         // Feedback processing
         float filterFreq = 8000.0f;
@@ -93,110 +172,304 @@ public:
         // I/O
         float inputGain = 1.0f;
         float outputGain = 1.0f;
+
+        // Delay read quality
+        InterpolationMode interpolation = InterpolationMode::Automatic;
+        bool nonRealtime = false;  // Host is rendering offline
+
+        // tanh kernels for drive and the feedback limiter
+        SaturationAccuracy saturationAccuracy = SaturationAccuracy::Automatic;
+
+        // Oversampling of the nonlinear stages while drive is up (1, 2 or 4)
+        int oversampling = 2;
+
+        // Multi-tap mode: the first numTaps taps replace the main delay read,
+        // and their sends (scaled by feedback) drive the feedback chain
+        bool multiTap = false;
+        int numTaps = 4;
+        std::array<DelayTap, MAX_TAPS> taps;
     };
 
+    // Continuous parameters are smoothed per sample toward these values;
+    // discrete ones (modes, switches) and filter settings apply per block.
     void setParameters(const Parameters& params)
     {
         currentParams = params;
 
-        lfo.setShape(LFOShape::Sine);  // Will be controlled by param later
-        stereoProc.setMode(params.stereoMode);
-        stereoProc.setWidth(params.width);
+        const std::array<float, NumSmoothed> targets = {
+            params.delayTimeMs, params.delayTimeRightMs, params.feedback, params.mix,
+            params.inputGain, params.outputGain, std::clamp(params.width, 0.0f, 2.0f),
+            params.duckAmount, params.modDepth, params.drive
+        };
 
-        for (auto& fb : feedbackProcessors)
+        for (size_t i = 0; i < NumSmoothed; ++i)
+        {
+            if (snapSmoothers)
+                smoother.snapTo(i, targets[i]);
+            else
+                smoother.setTarget(i, targets[i]);
+        }
+
+        setTapTargets(params);
+        snapSmoothers = false;
+
+        // Block-rate settings: only touch sub-processors when something changed
+        setLFOShape(params.lfoShape);
+        lfo.setControlRate(params.lfoControlRate);
+
+        if (params.stereoMode != stereoProc.getMode())
+            stereoProc.setMode(params.stereoMode);
+
+        if (params.freeze != delayLine.isFrozen())
+            setFrozen(params.freeze);
+
+        SaturationAccuracy accuracy = params.saturationAccuracy;
+        if (accuracy == SaturationAccuracy::Automatic)
+            accuracy = params.nonRealtime ? SaturationAccuracy::Exact : SaturationAccuracy::High;
+
+        if (accuracy != saturationAccuracy)
+        {
+            saturationAccuracy = accuracy;
+            for (auto& fb : feedbackProcessors)
+                fb.setSaturationAccuracy(accuracy);
+        }
+
+        if (params.oversampling != oversampling)
         {
-            fb.setFilterParams(params.filterFreq, params.filterRes, params.filterMode);
-            fb.setDamping(params.damping);
+            oversampling = params.oversampling;
+            for (auto& fb : feedbackProcessors)
+                fb.setOversampling(oversampling);
+            for (auto& os : limiterOversamplers)
+                os.setFactor(oversampling);
+        }
+
+        // One coefficient set, computed on change and shared by every channel
+        if (feedbackCoeffs.update(params.filterFreq, params.filterRes, params.filterMode, params.damping))
+        {
+            for (auto& fb : feedbackProcessors)
+                fb.setCoefficients(feedbackCoeffs.get());
         }
     }
 
     void setLFOShape(LFOShape shape)
     {
-        lfo.setShape(shape);
+        if (shape != lfo.getShape())
+            lfo.setShape(shape);
     }
 
+    // Debug counter: transcendental coefficient recomputes (filter, damping,
+    // ducking) since construction. Stays flat while parameters are idle.
+    int getCoefficientRecomputeCount() const
+    {
+        return feedbackCoeffs.getRecomputeCount() + ducker.getRecomputeCount();
+    }
+
+    // Block-based, staged processing.
+    //
+    // The host buffer is split into sub-blocks no longer than the shortest
+    // feedback round-trip (the minimum modulated delay, less the
+    // interpolator's look-ahead). Within such a sub-block no read can see a
+    // sample written in the same sub-block, so every stage (gain, LFO, delay
+    // read, feedback chain, write, ducking, width, mix) runs as its own loop
+    // over contiguous arrays.
+    //
+    // The interpolator is chosen per block (see selectInterpolation()).
+    // Tolerance vs processScalar() with InterpolationMode::Hermite, the
+    // reference's interpolator: each stage performs the same per-sample
+    // arithmetic in the same order, so unmodulated patches are bit-identical
+    // and modulated ones agree to float rounding (under 1e-6). The modulation
+    // offset is scaled in its own pass so no multiply-add in the delay-time
+    // loops is left for the compiler to fuse differently from processScalar;
+    // a one-ulp move of the read position would cost up to 2e-2 on noise.
+    //
+    // Smoothed parameters are rendered once per chunk of up to maxBlockSize
+    // samples; stages read the ramp only for parameters that are moving.
+    //
+    // channels holds one array per channel of the prepared layout.
+    void process(float* const* channels, int numSamples)
+    {
+        updateLiveTaps();
+        updateOversamplingEnabled();
+        selectInterpolation();
+        updateRequiredDelay();
+        beginTelemetry();
+
+        const int lookahead = getLookahead(activeInterpolation);
+        int pos = 0;
+
+        while (pos < numSamples)
+        {
+            int chunk = std::min(numSamples - pos, maxBlockSize);
+
+            // Bound from the ramp end points, before they advance
+            const int maxSubBlock = getMaxSubBlockLength(lookahead);
+            smoother.renderBlock(chunk);
+
+            for (int offset = 0; offset < chunk;)
+            {
+                int len = std::min(chunk - offset, maxSubBlock);
+
+                float* io[maxChannels];
+                for (int ch = 0; ch < numChannels; ++ch)
+                    io[ch] = channels[ch] + pos + offset;
+
+                processSubBlock(io, offset, len);
+                offset += len;
+            }
+
+            pos += chunk;
+        }
+
+        endTelemetry(numSamples);
+    }
+
+    // Stereo layouts
     void process(float* leftChannel, float* rightChannel, int numSamples)
     {
+        float* channels[2] = { leftChannel, rightChannel };
+        process(channels, numSamples);
+    }
+
+    // Per-sample reference implementation. Kept for validating the block path.
+    void processScalar(float* const* channels, int numSamples)
+    {
+        updateLiveTaps();
+        updateOversamplingEnabled();
+        updateRequiredDelay();
+
+        float in[maxChannels], wet[maxChannels], send[maxChannels];
+        float delays[maxChannels], frame[maxChannels];
+
         for (int i = 0; i < numSamples; ++i)
         {
+            const auto p = smoother.getNextValues();
+
             // Apply input gain
-            float inL = leftChannel[i] * currentParams.inputGain;
-            float inR = rightChannel[i] * currentParams.inputGain;
+            for (int ch = 0; ch < numChannels; ++ch)
+                in[ch] = channels[ch][i] * p[InputGain];
 
             // Get modulation
             float modValue = lfo.process(currentParams.modRateHz);
-            float modOffset = modValue * currentParams.modDepth * 20.0f;  // +/- 20ms max
+            float modOffset = modValue * p[ModDepth] * 20.0f;  // +/- 20ms max
 
             // Calculate delay times
-            float delayL = std::clamp(currentParams.delayTimeMs + modOffset, 1.0f, MAX_DELAY_MS);
-            float delayR = std::clamp(currentParams.delayTimeRightMs + modOffset, 1.0f, MAX_DELAY_MS);
-
-            float wetL, wetR;
+            float delayL = std::clamp(p[DelayTime] + modOffset, 1.0f, MAX_DELAY_MS);
+            float delayR = std::clamp(p[DelayTimeRight] + modOffset, 1.0f, MAX_DELAY_MS);
 
             if (currentParams.freeze)
             {
-                // Read from freeze buffer
-                wetL = freezeBuffers[0][freezeReadPos];
-                wetR = freezeBuffers[1][freezeReadPos];
-                freezeReadPos = (freezeReadPos + 1) % static_cast<int>(freezeBuffers[0].size());
+                // Loop the audio held in the delay line
+                delayLine.readFrozen(wet);
             }
             else
             {
-                // Write input + feedback to delay lines
-                float toWriteL = inL + feedbackSamples[0] * currentParams.feedback;
-                float toWriteR = inR + feedbackSamples[1] * currentParams.feedback;
+                // Taken off every read (see getLoopLatency), before the
+                // stages below advance
+                const float latency = getLoopLatency(0);
+
+                // Write input + feedback to delay lines, soft limited to
+                // prevent runaway
+                for (int ch = 0; ch < numChannels; ++ch)
+                    frame[ch] = softLimit(in[ch] + feedbackSamples[static_cast<size_t>(ch)] * p[Feedback], ch);
+
+                delayLine.write(frame);
 
-                // Soft limit feedback to prevent runaway
-                toWriteL = softLimit(toWriteL);
-                toWriteR = softLimit(toWriteR);
+                // Feedback chain input: the wet signal, or the taps' sends
+                if (currentParams.multiTap)
+                {
+                    std::fill(wet, wet + numChannels, 0.0f);
+                    std::fill(send, send + numChannels, 0.0f);
 
-                delayLines[0].write(toWriteL);
-                delayLines[1].write(toWriteR);
+                    for (int t = 0; t < liveTaps; ++t)
+                    {
+                        auto& tap = tapSmoothers[static_cast<size_t>(t)];
+                        float tapTime = tap.time.getNextValue();
+                        const float gains[NumRoles] = { tap.gainLeft.getNextValue(),
+                                                        tap.gainRight.getNextValue(),
+                                                        tap.gainCentre.getNextValue() };
+                        float tapSend = tap.send.getNextValue();
 
-                // Read from delay lines with interpolation
-                wetL = delayLines[0].read(delayLines[0].msToSamples(delayL));
-                wetR = delayLines[1].read(delayLines[1].msToSamples(delayR));
+                        float delay = delayLine.msToSamples(std::clamp(tapTime + modOffset, 1.0f, MAX_DELAY_MS)) - latency;
+                        std::fill(delays, delays + numChannels, delay);
+                        delayLine.read(delays, frame);
+
+                        for (int ch = 0; ch < numChannels; ++ch)
+                        {
+                            wet[ch] += frame[ch] * gains[roleOf(ch)];
+                            send[ch] += frame[ch] * tapSend;
+                        }
+                    }
+                }
+                else
+                {
+                    // Read from delay line with interpolation
+                    for (int ch = 0; ch < numChannels; ++ch)
+                        delays[ch] = delayLine.msToSamples(roleOf(ch) == Right ? delayR : delayL) - latency;
+
+                    delayLine.read(delays, wet);
+                    std::copy(wet, wet + numChannels, send);
+                }
 
                 // Process feedback through filter/saturation
-                float fbL = feedbackProcessors[0].process(wetL, currentParams.drive);
-                float fbR = feedbackProcessors[1].process(wetR, currentParams.drive);
+                for (int ch = 0; ch < numChannels; ++ch)
+                    frame[ch] = feedbackProcessors[static_cast<size_t>(ch)].process(send[ch], p[Drive]);
 
                 // Apply ping-pong if needed
-                stereoProc.processPingPongFeedback(fbL, fbR);
-
-                feedbackSamples[0] = fbL;
-                feedbackSamples[1] = fbR;
+                for (int pair = 0; pair < layout.numPairs; ++pair)
+                    stereoProc.processPingPongFeedback(frame[2 * pair], frame[2 * pair + 1]);
 
-                // Update freeze buffer continuously
-                updateFreezeBuffer(wetL, wetR);
+                std::copy(frame, frame + numChannels, feedbackSamples.begin());
             }
 
             // Apply ducking if enabled
             if (currentParams.duckingEnabled)
             {
-                float inputLevel = std::max(std::abs(inL), std::abs(inR));
+                float inputLevel = std::abs(in[0]);
+                for (int ch = 1; ch < numChannels; ++ch)
+                    inputLevel = std::max(inputLevel, std::abs(in[ch]));
+
                 ducker.process(inputLevel);
-                wetL = ducker.applyDucking(wetL, currentParams.duckAmount);
-                wetR = ducker.applyDucking(wetR, currentParams.duckAmount);
+                for (int ch = 0; ch < numChannels; ++ch)
+                    wet[ch] = ducker.applyDucking(wet[ch], p[DuckAmount]);
             }
 
             // Apply stereo width processing
-            stereoProc.process(wetL, wetR);
-
-            // Mix dry/wet
-            float outL = inL * (1.0f - currentParams.mix) + wetL * currentParams.mix;
-            float outR = inR * (1.0f - currentParams.mix) + wetR * currentParams.mix;
+            stereoProc.setWidth(p[Width]);
+            for (int pair = 0; pair < layout.numPairs; ++pair)
+                stereoProc.process(wet[2 * pair], wet[2 * pair + 1]);
 
-            // Apply output gain
-            leftChannel[i] = outL * currentParams.outputGain;
-            rightChannel[i] = outR * currentParams.outputGain;
+            // Mix dry/wet and apply output gain
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                float out = in[ch] * (1.0f - p[Mix]) + wet[ch] * p[Mix];
+                channels[ch][i] = out * p[OutputGain];
+            }
         }
     }
 
-    // For metering
+    void processScalar(float* leftChannel, float* rightChannel, int numSamples)
+    {
+        float* channels[2] = { leftChannel, rightChannel };
+        processScalar(channels, numSamples);
+    }
+
+    // Per-block summary for meters, filled in by process() (not
+    // processScalar()) while enabled. Read it on the audio thread after
+    // process() and hand it on, e.g. through a TelemetryFifo.
+    // Enable before prepare() to also keep the delay line's waveform summary.
+    void setTelemetryEnabled(bool shouldBeEnabled) { telemetryEnabled = shouldBeEnabled; }
+    const BlockTelemetry& getBlockTelemetry() const { return blockTelemetry; }
+
+    // Min/max of what the delay line holds; readable from any thread
+    const WaveformSummary& getWaveformSummary() const { return waveform; }
+
+    // Current state; audio thread only
     float getFeedbackLevel() const
     {
-        return std::max(std::abs(feedbackSamples[0]), std::abs(feedbackSamples[1]));
+        float level = 0.0f;
+        for (float sample : feedbackSamples)
+            level = std::max(level, std::abs(sample));
+        return level;
     }
 
     float getLFOValue() const
@@ -204,45 +477,777 @@ public:
         return lfo.getPhase();
     }
 
+    // For renders that start part way into a file; call after setParameters()
+    void setLFOPhase(float phase) { lfo.setPhase(phase); }
+
+    // Repeatable random LFO shapes, e.g. for validation; call after prepare()
+    void setLFOSeed(unsigned int seed) { lfo.setSeed(seed); }
+
+    InterpolationMode getActiveInterpolation() const { return activeInterpolation; }
+
+    // Commits and frees delay-line pages; call periodically off the audio
+    // thread (or after each block when rendering offline)
+    void serviceDelayMemory() { delayLine.servicePages(); }
+    size_t getDelayMemoryBytes() const { return delayLine.getMemoryBytes(); }
+    DelayStorage getDelayStorage() const { return delayLine.getStorage(); }
+
 private:
-    void updateFreezeBuffer(float left, float right)
+    // Parameters smoothed per sample
+    enum Smoothed
+    {
+        DelayTime, DelayTimeRight,
+        Feedback, Mix,
+        InputGain, OutputGain,
+        Width, DuckAmount,
+        ModDepth, Drive,
+        NumSmoothed
+    };
+
+    // Delay time ramps are slower so automation glides like tape
+    static constexpr std::array<float, NumSmoothed> smoothingTimesMs = {
+        100.0f, 100.0f,
+        20.0f, 20.0f,
+        20.0f, 20.0f,
+        20.0f, 20.0f,
+        50.0f, 20.0f
+    };
+
+    using Ramp = ParameterSmoother<NumSmoothed>::Ramp;
+
+    // Multi-tap ramps, timed like their single-delay counterparts
+    struct TapSmoothers
+    {
+        LinearSmoother time;
+        LinearSmoother gainLeft;
+        LinearSmoother gainRight;
+        LinearSmoother gainCentre;  // Single channels: level without pan
+        LinearSmoother send;
+    };
+
+    // Where a channel sits in the layout
+    enum ChannelRole
+    {
+        Left, Right, Single,
+        NumRoles
+    };
+
+    ChannelRole roleOf(int ch) const
+    {
+        if (ch >= 2 * layout.numPairs)
+            return Single;
+        return (ch & 1) == 0 ? Left : Right;
+    }
+
+    Ramp param(Smoothed which, int offset) const { return smoother.getRamp(which, offset); }
+
+    // Block-sized scratch shared by all channels
+    enum Scratch
+    {
+        Mod,
+        DelayL, DelayR, LoopLatency,
+        DuckGain,
+        TapDelay,
+        TapGainL, TapGainR, TapGainC, TapSend,
+        NumScratch
+    };
+
+    // Block-sized scratch, one array per channel
+    enum ChannelScratch
+    {
+        Dry, Wet,
+        FeedbackOut, WriteIn,
+        TapOut, Send,
+        NumChannelScratch
+    };
+
+    float* scratchBuffer(Scratch which) { return scratch[which]; }
+
+    float* channelBuffer(ChannelScratch which, int ch)
+    {
+        return channelScratch[which] + static_cast<size_t>(ch) * static_cast<size_t>(maxBlockSize);
+    }
+
+    // Pointers to every channel's array of one ChannelScratch stage
+    struct ChannelPointers
+    {
+        float* data[maxChannels];
+        float*& operator[](int ch) { return data[ch]; }
+        operator float* const*() const { return data; }
+    };
+
+    ChannelPointers channelBuffers(ChannelScratch which)
+    {
+        ChannelPointers pointers;
+        for (int ch = 0; ch < numChannels; ++ch)
+            pointers[ch] = channelBuffer(which, ch);
+        return pointers;
+    }
+
+    // Pages to keep: the longest delay the ramps and modulation can reach.
+    // Ramps are linear, so their end points bound them.
+    void updateRequiredDelay()
+    {
+        float maxDelayMs = std::max({ smoother.getCurrent(DelayTime), smoother.getTarget(DelayTime),
+                                      smoother.getCurrent(DelayTimeRight), smoother.getTarget(DelayTimeRight) });
+        for (int t = 0; t < liveTaps; ++t)
+        {
+            const auto& time = tapSmoothers[static_cast<size_t>(t)].time;
+            maxDelayMs = std::max({ maxDelayMs, time.getCurrent(), time.getTarget() });
+        }
+
+        float maxModDepth = std::max(std::abs(smoother.getCurrent(ModDepth)), std::abs(smoother.getTarget(ModDepth)));
+
+        maxDelayMs = std::clamp(maxDelayMs + maxModDepth * 20.0f, 1.0f, MAX_DELAY_MS);
+        delayLine.setRequiredDelay(delayLine.msToSamples(maxDelayMs) + static_cast<float>(Interpolation::maxTaps));
+    }
+
+    // Longest sub-block for which no delay read reaches a sample written in
+    // the same sub-block (see process()).
+    // Ramps are linear, so the extremes over a chunk are at its end points.
+    int getMaxSubBlockLength(int lookahead) const
+    {
+        float minDelayMs = std::min({ smoother.getCurrent(DelayTime), smoother.getTarget(DelayTime),
+                                      smoother.getCurrent(DelayTimeRight), smoother.getTarget(DelayTimeRight) });
+        for (int t = 0; t < liveTaps; ++t)
+        {
+            const auto& time = tapSmoothers[static_cast<size_t>(t)].time;
+            minDelayMs = std::min({ minDelayMs, time.getCurrent(), time.getTarget() });
+        }
+
+        float maxModDepth = std::max(std::abs(smoother.getCurrent(ModDepth)), std::abs(smoother.getTarget(ModDepth)));
+
+        minDelayMs -= maxModDepth * 20.0f;
+        minDelayMs = std::clamp(minDelayMs, 1.0f, MAX_DELAY_MS);
+
+        int minDelaySamples = static_cast<int>(delayLine.msToSamples(minDelayMs) - getMaxLoopLatency());
+        return std::max(minDelaySamples - lookahead, 1);
+    }
+
+    static int getLookahead(InterpolationMode mode)
+    {
+        switch (mode)
+        {
+            case InterpolationMode::Integer: return Interpolation::Integer::lookahead;
+            case InterpolationMode::Linear:  return Interpolation::Linear::lookahead;
+            case InterpolationMode::Thiran:  return Interpolation::Thiran::lookahead;
+            case InterpolationMode::Sinc:    return Interpolation::Sinc::lookahead;
+            default:                         return Interpolation::Hermite::lookahead;
+        }
+    }
+
+    bool isWholeSamples(float ms) const
+    {
+        float samples = delayLine.msToSamples(ms);
+        return samples == std::floor(samples);
+    }
+
+    // Picks the cheapest interpolator that is transparent for this block:
+    // windowed sinc for offline renders, Hermite while the delay moves,
+    // no interpolation for static whole-sample delays, and the flat-magnitude
+    // Thiran allpass for static fractional delays. The loop latency taken off
+    // the reads counts: it is fractional, and moves while an oversampler
+    // fades. Call after updateOversamplingEnabled().
+    void selectInterpolation()
+    {
+        InterpolationMode mode = currentParams.interpolation;
+
+        if (mode == InterpolationMode::Automatic)
+        {
+            bool moving = currentParams.modDepth > 0.0f
+                       || smoother.isMoving(ModDepth)
+                       || smoother.isMoving(DelayTime)
+                       || smoother.isMoving(DelayTimeRight)
+                       || isLoopLatencyChanging();
+            bool wholeSamples = getLoopLatency(0) == 0.0f
+                             && isWholeSamples(currentParams.delayTimeMs) && isWholeSamples(currentParams.delayTimeRightMs);
+
+            for (int t = 0; t < liveTaps; ++t)
+            {
+                const auto& time = tapSmoothers[static_cast<size_t>(t)].time;
+                moving = moving || time.isMoving();
+                wholeSamples = wholeSamples && isWholeSamples(time.getTarget());
+            }
+
+            if (currentParams.nonRealtime)
+                mode = InterpolationMode::Sinc;
+            else if (moving)
+                mode = InterpolationMode::Hermite;
+            else if (wholeSamples)
+                mode = InterpolationMode::Integer;
+            else
+                mode = InterpolationMode::Thiran;
+        }
+
+        // Start the allpass from the last output rather than zero so switching
+        // in does not step
+        if (mode == InterpolationMode::Thiran && activeInterpolation != InterpolationMode::Thiran)
+        {
+            for (size_t ch = 0; ch < thiranStates.size(); ++ch)
+            {
+                thiranStates[ch] = {};
+                thiranStates[ch].lastOutput = lastWetSamples[ch];
+            }
+
+            std::fill(tapThiranStates.begin(), tapThiranStates.end(), Interpolation::Thiran::State {});
+        }
+
+        activeInterpolation = mode;
+    }
+
+    template <typename Interp>
+    void readSubBlock(const float* const* delays, float* const* wet, int numSamples,
+                      typename Interp::State* states)
+    {
+        delayLine.readBlock<Interp>(delays, wet, numSamples, states);
+    }
+
+    void processSubBlock(float* const* channels, int offset, int numSamples)
+    {
+        auto dry = channelBuffers(Dry);
+        auto wet = channelBuffers(Wet);
+
+        // Input gain
+        const Ramp inputGain = param(InputGain, offset);
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const float* in = channels[ch];
+            float* out = dry[ch];
+
+            if (inputGain.isMoving())
+            {
+                for (int i = 0; i < numSamples; ++i)
+                    out[i] = in[i] * inputGain.values[i];
+            }
+            else
+            {
+                for (int i = 0; i < numSamples; ++i)
+                    out[i] = in[i] * inputGain.constant;
+            }
+
+            if (telemetryEnabled)
+                inputStats.add(out, numSamples);
+        }
+
+        // LFO render, then scaled to a delay offset in ms (+/- 20ms max). The
+        // scaling gets its own pass so the delay reads only add it, and round
+        // the same as processScalar even where the compiler fuses multiply-adds.
+        float* mod = scratchBuffer(Mod);
+        lfo.renderBlock(mod, numSamples, currentParams.modRateHz);
+        {
+            const Ramp modDepth = param(ModDepth, offset);
+            for (int i = 0; i < numSamples; ++i)
+                mod[i] = mod[i] * modDepth[i] * 20.0f;
+        }
+
+        if (currentParams.freeze)
+        {
+            delayLine.readFrozenBlock(wet, numSamples);
+        }
+        else
+        {
+            processDelaySubBlock(dry, mod, wet, offset, numSamples);
+        }
+
+        // Ducking, keyed by the loudest channel
+        if (currentParams.duckingEnabled)
+        {
+            float* duckGain = scratchBuffer(DuckGain);
+            for (int i = 0; i < numSamples; ++i)
+                duckGain[i] = std::abs(dry[0][i]);
+            for (int ch = 1; ch < numChannels; ++ch)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                    duckGain[i] = std::max(duckGain[i], std::abs(dry[ch][i]));
+            }
+
+            const Ramp duckAmount = param(DuckAmount, offset);
+            if (duckAmount.isMoving())
+                ducker.processBlock(duckGain, duckGain, numSamples, duckAmount.values);
+            else
+                ducker.processBlock(duckGain, duckGain, numSamples, duckAmount.constant);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                    wet[ch][i] *= duckGain[i];
+            }
+
+            if (telemetryEnabled)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                    minDuckGain = std::min(minDuckGain, duckGain[i]);
+            }
+        }
+
+        // Stereo width, per pair
+        const Ramp width = param(Width, offset);
+        if (!width.isMoving())
+            stereoProc.setWidth(width.constant);
+
+        for (int pair = 0; pair < layout.numPairs; ++pair)
+        {
+            if (width.isMoving())
+                stereoProc.processBlock(wet[2 * pair], wet[2 * pair + 1], numSamples, width.values);
+            else
+                stereoProc.processBlock(wet[2 * pair], wet[2 * pair + 1], numSamples);
+        }
+
+        if (telemetryEnabled)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+                wetStats.add(wet[ch], numSamples);
+        }
+
+        // Mix and output gain
+        const Ramp mix = param(Mix, offset);
+        const Ramp outputGain = param(OutputGain, offset);
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const float* in = dry[ch];
+            const float* w = wet[ch];
+            float* out = channels[ch];
+
+            if (!mix.isMoving() && !outputGain.isMoving())
+            {
+                for (int i = 0; i < numSamples; ++i)
+                    out[i] = (in[i] * (1.0f - mix.constant) + w[i] * mix.constant) * outputGain.constant;
+            }
+            else
+            {
+                for (int i = 0; i < numSamples; ++i)
+                    out[i] = (in[i] * (1.0f - mix[i]) + w[i] * mix[i]) * outputGain[i];
+            }
+        }
+    }
+
+    // Delay read with the active interpolator. thiran is the allpass state of
+    // this read (the main delay or one tap), one per channel.
+    void readActiveSubBlock(const float* const* delays, float* const* wet, int numSamples,
+                            Interpolation::Thiran::State* thiran)
+    {
+        switch (activeInterpolation)
+        {
+            case InterpolationMode::Integer:
+            {
+                Interpolation::Integer::State states[maxChannels];
+                readSubBlock<Interpolation::Integer>(delays, wet, numSamples, states);
+                break;
+            }
+            case InterpolationMode::Linear:
+            {
+                Interpolation::Linear::State states[maxChannels];
+                readSubBlock<Interpolation::Linear>(delays, wet, numSamples, states);
+                break;
+            }
+            case InterpolationMode::Thiran:
+                readSubBlock<Interpolation::Thiran>(delays, wet, numSamples, thiran);
+                break;
+            case InterpolationMode::Sinc:
+            {
+                Interpolation::Sinc::State states[maxChannels];
+                readSubBlock<Interpolation::Sinc>(delays, wet, numSamples, states);
+                break;
+            }
+            default:
+            {
+                Interpolation::Hermite::State states[maxChannels];
+                readSubBlock<Interpolation::Hermite>(delays, wet, numSamples, states);
+                break;
+            }
+        }
+
+    }
+
+    // Main delay read (nothing in this sub-block has been written yet). mod
+    // is the modulation offset in ms; latency is taken off the delay times
+    // when not null.
+    void readMainSubBlock(const float* mod, const float* latency, float* const* wet, int offset, int numSamples)
+    {
+        float* delayL = scratchBuffer(DelayL);
+        float* delayR = scratchBuffer(DelayR);
+
+        // Modulated delay times, in samples
+        const Ramp delayTime = param(DelayTime, offset);
+        const Ramp delayTimeRight = param(DelayTimeRight, offset);
+        if (layout.numPairs > 0)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                delayL[i] = delayLine.msToSamples(std::clamp(delayTime[i] + mod[i], 1.0f, MAX_DELAY_MS));
+                delayR[i] = delayLine.msToSamples(std::clamp(delayTimeRight[i] + mod[i], 1.0f, MAX_DELAY_MS));
+            }
+        }
+        else
+        {
+            for (int i = 0; i < numSamples; ++i)
+                delayL[i] = delayLine.msToSamples(std::clamp(delayTime[i] + mod[i], 1.0f, MAX_DELAY_MS));
+        }
+
+        if (latency != nullptr)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                delayL[i] -= latency[i];
+
+            if (layout.numPairs > 0)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                    delayR[i] -= latency[i];
+            }
+        }
+
+        const float* delays[maxChannels];
+        for (int ch = 0; ch < numChannels; ++ch)
+            delays[ch] = roleOf(ch) == Right ? delayR : delayL;
+
+        readActiveSubBlock(delays, wet, numSamples, thiranStates.data());
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            lastWetSamples[static_cast<size_t>(ch)] = wet[ch][numSamples - 1];
+    }
+
+    // Multi-tap read. Each live tap is one block read of the shared delay
+    // line, summed into the wet signal through its pan gains and into the
+    // feedback sends. mod and latency as for readMainSubBlock.
+    void readTapsSubBlock(const float* mod, const float* latency, float* const* wet, float* const* send,
+                          int numSamples)
+    {
+        float* delay = scratchBuffer(TapDelay);
+        float* tapSend = scratchBuffer(TapSend);
+        auto tapOut = channelBuffers(TapOut);
+
+        // Gain array for each channel role
+        const float* roleGains[NumRoles] = { scratchBuffer(TapGainL), scratchBuffer(TapGainR), scratchBuffer(TapGainC) };
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            std::fill(wet[ch], wet[ch] + numSamples, 0.0f);
+            std::fill(send[ch], send[ch] + numSamples, 0.0f);
+        }
+
+        const float* delays[maxChannels];
+        std::fill(delays, delays + numChannels, delay);
+
+        for (int t = 0; t < liveTaps; ++t)
+        {
+            auto& tap = tapSmoothers[static_cast<size_t>(t)];
+
+            tap.time.render(delay, numSamples);
+            for (int i = 0; i < numSamples; ++i)
+                delay[i] = delayLine.msToSamples(std::clamp(delay[i] + mod[i], 1.0f, MAX_DELAY_MS));
+
+            if (latency != nullptr)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                    delay[i] -= latency[i];
+            }
+
+            readActiveSubBlock(delays, tapOut, numSamples, &tapThiranStates[static_cast<size_t>(t * numChannels)]);
+
+            tap.gainLeft.render(scratchBuffer(TapGainL), numSamples);
+            tap.gainRight.render(scratchBuffer(TapGainR), numSamples);
+            tap.gainCentre.render(scratchBuffer(TapGainC), numSamples);
+            tap.send.render(tapSend, numSamples);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                const float* in = tapOut[ch];
+                const float* gain = roleGains[roleOf(ch)];
+                float* w = wet[ch];
+                float* fb = send[ch];
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    w[i] += in[i] * gain[i];
+                    fb[i] += in[i] * tapSend[i];
+                }
+            }
+        }
+    }
+
+    void processDelaySubBlock(const float* const* dry, const float* mod, float* const* wet,
+                              int offset, int numSamples)
+    {
+        // Feedback chain input: the wet signal, or the taps' sends
+        float* const* send = wet;
+        auto tapSends = channelBuffers(Send);
+        const float* latency = renderLoopLatency(numSamples) ? scratchBuffer(LoopLatency) : nullptr;
+
+        if (currentParams.multiTap)
+        {
+            readTapsSubBlock(mod, latency, wet, tapSends, numSamples);
+            send = tapSends;
+        }
+        else
+        {
+            readMainSubBlock(mod, latency, wet, offset, numSamples);
+        }
+
+        // Feedback chain
+        auto fb = channelBuffers(FeedbackOut);
+        const Ramp drive = param(Drive, offset);
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto& processor = feedbackProcessors[static_cast<size_t>(ch)];
+            if (drive.isMoving())
+                processor.processBlock(send[ch], fb[ch], numSamples, drive.values);
+            else
+                processor.processBlock(send[ch], fb[ch], numSamples, drive.constant);
+
+            if (telemetryEnabled)
+                feedbackStats.add(fb[ch], numSamples);
+        }
+
+        if (stereoProc.getMode() == StereoMode::PingPong)
+        {
+            for (int pair = 0; pair < layout.numPairs; ++pair)
+                std::swap(fb[2 * pair], fb[2 * pair + 1]);
+        }
+
+        // Write input + previous sample's feedback
+        auto write = channelBuffers(WriteIn);
+        const Ramp feedback = param(Feedback, offset);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const float* in = dry[ch];
+            const float* fbIn = fb[ch];
+            float* out = write[ch];
+
+            out[0] = in[0] + feedbackSamples[static_cast<size_t>(ch)] * feedback[0];
+            for (int i = 1; i < numSamples; ++i)
+                out[i] = in[i] + fbIn[i - 1] * feedback[i];
+
+            softLimitBlock(out, out, numSamples, ch);
+            feedbackSamples[static_cast<size_t>(ch)] = fbIn[numSamples - 1];
+        }
+
+        if (telemetryEnabled)
+            waveform.write(write, numChannels, numSamples);
+
+        delayLine.writeBlock(write, numSamples);
+    }
+
+    // Taps past numTaps (or all of them outside multi-tap mode) fade out
+    // before they stop being read
+    void setTapTargets(const Parameters& params)
     {
-        freezeBuffers[0][freezeWritePos] = left;
-        freezeBuffers[1][freezeWritePos] = right;
-        freezeWritePos = (freezeWritePos + 1) % static_cast<int>(freezeBuffers[0].size());
+        for (int t = 0; t < MAX_TAPS; ++t)
+        {
+            const auto& tap = params.taps[static_cast<size_t>(t)];
+            auto& smoothers = tapSmoothers[static_cast<size_t>(t)];
+            bool active = params.multiTap && t < params.numTaps;
+
+            float level = active ? tap.level : 0.0f;
+            float pan = std::clamp(tap.pan, -1.0f, 1.0f);
+            const std::array<std::pair<LinearSmoother*, float>, 5> targets = {{
+                { &smoothers.time, std::clamp(tap.timeMs, 1.0f, MAX_DELAY_MS) },
+                { &smoothers.gainLeft, level * std::min(1.0f, 1.0f - pan) },
+                { &smoothers.gainRight, level * std::min(1.0f, 1.0f + pan) },
+                { &smoothers.gainCentre, level },
+                { &smoothers.send, active ? tap.feedback : 0.0f }
+            }};
+
+            for (const auto& [ramp, value] : targets)
+            {
+                if (snapSmoothers)
+                    ramp->snapTo(value);
+                else
+                    ramp->setTarget(value);
+            }
+        }
     }
 
-    float softLimit(float x)
+    // Taps read this block: up to the last one still audible or fading
+    void updateLiveTaps()
     {
-        // Soft saturation to prevent feedback runaway
-        if (x > 1.0f)
-            return 1.0f + std::tanh(x - 1.0f);
-        else if (x < -1.0f)
-            return -1.0f + std::tanh(x + 1.0f);
-        return x;
+        liveTaps = 0;
+        if (!currentParams.multiTap)
+            return;
+
+        for (int t = 0; t < MAX_TAPS; ++t)
+        {
+            const auto& tap = tapSmoothers[static_cast<size_t>(t)];
+            bool audible = tap.gainLeft.isMoving() || tap.gainRight.isMoving()
+                        || tap.gainCentre.isMoving() || tap.send.isMoving()
+                        || tap.gainLeft.getCurrent() != 0.0f || tap.gainRight.getCurrent() != 0.0f
+                        || tap.gainCentre.getCurrent() != 0.0f || tap.send.getCurrent() != 0.0f;
+            if (audible)
+                liveTaps = t + 1;
+        }
+    }
+
+    // Freeze stops writes and loops the last echo period held in the delay
+    // line, so the loop picks up exactly where the wet signal was. A delay of
+    // d samples repeats every d - 1 (the read follows the write).
+    void setFrozen(bool shouldFreeze)
+    {
+        if (!shouldFreeze)
+        {
+            delayLine.unfreeze();
+            return;
+        }
+
+        auto loopFrames = [this](float delayMs) {
+            return static_cast<int>(std::lround(delayLine.msToSamples(delayMs))) - 1;
+        };
+
+        float loopMsL = smoother.getCurrent(DelayTime);
+        float loopMsR = smoother.getCurrent(DelayTimeRight);
+
+        // Multi-tap loops the longest tap's period, so every tap's echo is held
+        if (currentParams.multiTap)
+        {
+            loopMsL = loopMsR = 1.0f;
+            for (int t = 0; t < std::clamp(currentParams.numTaps, 0, MAX_TAPS); ++t)
+                loopMsL = loopMsR = std::max(loopMsL, tapSmoothers[static_cast<size_t>(t)].time.getCurrent());
+        }
+
+        int loops[maxChannels];
+        for (int ch = 0; ch < numChannels; ++ch)
+            loops[ch] = loopFrames(roleOf(ch) == Right ? loopMsR : loopMsL);
+
+        delayLine.freeze(loops, static_cast<int>(delayLine.msToSamples(FREEZE_CROSSFADE_MS)));
+    }
+
+    // Soft saturation to prevent feedback runaway; oversampled with drive
+    void softLimitBlock(const float* input, float* output, int numSamples, int channel)
+    {
+        limiterOversamplers[static_cast<size_t>(channel)].process(
+            input, output, numSamples,
+            [this](const float* in, float* out, int len, int) {
+                FastMath::softClipBlock(in, out, len, saturationAccuracy);
+            });
+    }
+
+    float softLimit(float x, int channel)
+    {
+        float limited;
+        softLimitBlock(&x, &limited, 1, channel);
+        return limited;
+    }
+
+    void beginTelemetry()
+    {
+        if (!telemetryEnabled)
+            return;
+
+        inputStats.clear();
+        wetStats.clear();
+        feedbackStats.clear();
+        minDuckGain = 1.0f;
+    }
+
+    void endTelemetry(int numSamples)
+    {
+        if (!telemetryEnabled)
+            return;
+
+        blockTelemetry.inputPeak = inputStats.peak;
+        blockTelemetry.inputRms = inputStats.rms();
+        blockTelemetry.wetPeak = wetStats.peak;
+        blockTelemetry.wetRms = wetStats.rms();
+        blockTelemetry.feedbackPeak = feedbackStats.peak;
+        blockTelemetry.feedbackRms = feedbackStats.rms();
+        blockTelemetry.lfoPhase = lfo.getPhase();
+        blockTelemetry.duckGain = minDuckGain;
+        blockTelemetry.numSamples = numSamples;
+        blockTelemetry.frozen = currentParams.freeze;
+    }
+
+    // The oversampled stages round the loop (saturation, then the write
+    // limiter) delay each repeat by their latency, so reads are shortened by
+    // it and the repeats stay where the delay time puts them. The first echo
+    // only passes the limiter, so it lands the saturation's latency (3-4
+    // samples) early while drive is up. i is a sample of the next sub-block.
+    float getLoopLatency(int i) const
+    {
+        return feedbackProcessors[0].getLatencyAt(i) + limiterOversamplers[0].getLatencyAt(i);
+    }
+
+    bool isLoopLatencyChanging() const
+    {
+        return feedbackProcessors[0].isLatencyChanging() || limiterOversamplers[0].isLatencyChanging();
+    }
+
+    float getMaxLoopLatency() const
+    {
+        return feedbackProcessors[0].getMaxLatency() + limiterOversamplers[0].getLatencySamples();
+    }
+
+    // Fills LoopLatency for the next sub-block; false when there is none.
+    // It ramps monotonically, so the end points tell.
+    bool renderLoopLatency(int numSamples)
+    {
+        if (getLoopLatency(0) == 0.0f && getLoopLatency(numSamples - 1) == 0.0f)
+            return false;
+
+        float* latency = scratchBuffer(LoopLatency);
+        for (int i = 0; i < numSamples; ++i)
+            latency[i] = getLoopLatency(i);
+        return true;
+    }
+
+    // Drive is what pushes the nonlinear stages into aliasing; with it at 0
+    // they run at the base rate
+    void updateOversamplingEnabled()
+    {
+        bool driveActive = smoother.getCurrent(Drive) > 0.0f || smoother.getTarget(Drive) > 0.0f;
+
+        for (auto& fb : feedbackProcessors)
+            fb.setOversamplingEnabled(driveActive);
+        for (auto& os : limiterOversamplers)
+            os.setEnabled(driveActive);
     }
 
     float sampleRate = 44100.0f;
+    int maxBlockSize = 1;
+    ChannelLayout layout;
+    int numChannels = 2;
+
+    // Owns every block-sized buffer below; declared first so it outlives them
+    BufferArena arena;
+
+    // Per-stage scratch for the block path
+    std::array<float*, NumScratch> scratch {};
+    std::array<float*, NumChannelScratch> channelScratch {};
 
-    // Core delay lines (stereo)
-    std::array<DelayLine, 2> delayLines;
+    // Core delay line (interleaved frames)
+    MultiChannelDelayLine delayLine;
 
-    // Sub-processors
+    // Sub-processors; per-channel ones are sized by prepare()
     ModulationLFO lfo;
-    std::array<FeedbackProcessor, 2> feedbackProcessors;
+    std::vector<FeedbackProcessor> feedbackProcessors;
+    FeedbackCoefficientCache feedbackCoeffs;
     DuckingEnvelope ducker;
     StereoProcessor stereoProc;
+    SaturationAccuracy saturationAccuracy = SaturationAccuracy::Exact;
+    int oversampling = 2;
+    std::vector<Oversampler> limiterOversamplers;
+
+    // Feedback state, per channel
+    std::vector<float> feedbackSamples;
+
+    // Interpolation state, per channel
+    InterpolationMode activeInterpolation = InterpolationMode::Hermite;
+    std::vector<Interpolation::Thiran::State> thiranStates;
+    std::vector<float> lastWetSamples;
 
-    // Feedback state
-    std::array<float, 2> feedbackSamples = {0.0f, 0.0f};
+    // Multi-tap state; allpass states are numChannels per tap
+    std::array<TapSmoothers, MAX_TAPS> tapSmoothers;
+    std::vector<Interpolation::Thiran::State> tapThiranStates;
+    int liveTaps = 0;
 
-    // Freeze buffer
-    std::array<std::vector<float>, 2> freezeBuffers;
-    int freezeWritePos = 0;
-    int freezeReadPos = 0;
+    // Block telemetry, accumulated across sub-blocks
+    bool telemetryEnabled = false;
+    SignalStats inputStats, wetStats, feedbackStats;
+    float minDuckGain = 1.0f;
+    BlockTelemetry blockTelemetry;
+    WaveformSummary waveform;
 
     // Current parameters
     Parameters currentParams;
+    ParameterSmoother<NumSmoothed> smoother;
+    bool snapSmoothers = true;
 };
 
 } // namespace Chronos
@@ -0,0 +1,506 @@
+#pragma once
+
+#include "DelayEngine.h"
+#include <array>
+#include <algorithm>
+
+namespace Chronos {
+
+// Many independent delay voices advanced together, for batch rendering.
+//
+// Each lane is one mono engine with its own settings (a stereo stem takes two
+// lanes). Per-voice state is an array of Lanes values, and audio is held
+// lane-interleaved: frame i, lane l at [i * Lanes + l], in the delay ring and
+// in every block buffer. Processing is staged like DelayEngine::process():
+// sub-blocks are bounded by the shortest delay of any lane, so the stateless
+// stages (gains, limiter, drive, mix) are single loops over frames x lanes
+// and the recursive ones (LFO phase, feedback filter, damping) step every
+// lane at once per sample. Only the delay read and the LFO table gather.
+//
+// A lane is the core of DelayEngine: input gain, sine modulation, cubic
+// Hermite delay read, soft-limited write, drive, feedback filter, damping,
+// mix and output gain, with the same smoothing times. With the same settings
+// (Hermite interpolation, oversampling off, audio-rate LFO) a lane's output
+// is bit-identical to a mono DelayEngine's processScalar(). Stereo modes,
+// ducking, freeze, multi-tap and oversampling stay with DelayEngine.
+template <int Lanes = 8>
+class DelayEngineBank
+{
+public:
+    static_assert(Lanes == 4 || Lanes == 8 || Lanes == 16, "one SSE, AVX or AVX-512 register of lanes");
+
+    static constexpr int numLanes = Lanes;
+
+    struct LaneParameters
+    {
+        float delayTimeMs = 250.0f;
+        float feedback = 0.3f;
+        float mix = 0.5f;
+
+        float modRateHz = 0.5f;  // Sine LFO
+        float modDepth = 0.0f;
+
+        float filterFreq = 8000.0f;
+        float filterRes = 0.0f;
+        FilterMode filterMode = FilterMode::LowPass;
+        float damping = 0.3f;
+        float drive = 0.0f;
+
+        float inputGain = 1.0f;
+        float outputGain = 1.0f;
+    };
+
+    // The ring holds maxDelayMs for every lane. Not realtime safe.
+    void prepare(float sampleRate, float maxDelayMs)
+    {
+        this->sampleRate = sampleRate;
+        this->maxDelayMs = std::clamp(maxDelayMs, 1.0f, MAX_DELAY_MS);
+
+        int maxFrames = static_cast<int>(std::ceil(this->maxDelayMs * sampleRate / 1000.0f)) + 4;
+        capacity = nextPowerOfTwo(maxFrames);
+        mask = capacity - 1;
+
+        arena.release();
+        ring = arena.allocate<float>(static_cast<size_t>(capacity + guardFrames) * Lanes);
+        for (auto& buf : scratch)
+            buf = arena.allocate<float>(static_cast<size_t>(chunkFrames) * Lanes);
+        for (auto& buf : rampBuffers)
+            buf = arena.allocate<float>(static_cast<size_t>(chunkFrames) * Lanes);
+        arena.prefault();
+
+        for (size_t i = 0; i < NumSmoothed; ++i)
+            ramps[i].rampSamples = std::max(1, static_cast<int>(sampleRate * smoothingTimesMs[i] / 1000.0f));
+
+        for (auto& cache : coefficientCaches)
+            cache.prepare(sampleRate);
+
+        reset();
+    }
+
+    // Silences every lane; the next setParameters() of each lane snaps
+    void reset()
+    {
+        if (ring != nullptr)
+            std::fill(ring, ring + static_cast<size_t>(capacity + guardFrames) * Lanes, 0.0f);
+
+        writeIndex = 0;
+        phase.fill(0.0f);
+        ic1eq.fill(0.0f);
+        ic2eq.fill(0.0f);
+        dampState.fill(0.0f);
+        feedbackSample.fill(0.0f);
+        snapLane.fill(true);
+    }
+
+    // Continuous parameters ramp like DelayEngine's; filter settings apply
+    // from the next process() call
+    void setParameters(int lane, const LaneParameters& params)
+    {
+        const size_t l = static_cast<size_t>(lane);
+
+        const std::array<float, NumSmoothed> targets = {
+            params.delayTimeMs, params.feedback, params.mix,
+            params.inputGain, params.outputGain,
+            params.modDepth, params.drive
+        };
+
+        for (size_t i = 0; i < NumSmoothed; ++i)
+        {
+            if (snapLane[l])
+                ramps[i].snapTo(l, targets[i]);
+            else
+                ramps[i].setTarget(l, targets[i]);
+        }
+        snapLane[l] = false;
+
+        phaseIncrement[l] = params.modRateHz / sampleRate;
+
+        auto& cache = coefficientCaches[l];
+        cache.update(params.filterFreq, params.filterRes, params.filterMode, params.damping);
+
+        const auto& coeffs = cache.get();
+        a1[l] = coeffs.a1;
+        a2[l] = coeffs.a2;
+        a3[l] = coeffs.a3;
+        highPassK[l] = 2.0f - 2.0f * coeffs.resonance;
+        filterMode[l] = static_cast<int>(coeffs.mode);
+        dampCoeff[l] = coeffs.dampCoeff;
+    }
+
+    // Automatic resolves to Exact: the bank is for offline renders
+    void setSaturationAccuracy(SaturationAccuracy newAccuracy)
+    {
+        accuracy = newAccuracy == SaturationAccuracy::Automatic ? SaturationAccuracy::Exact : newAccuracy;
+    }
+
+    // lanes holds one array per lane, processed in place
+    void process(float* const* lanes, int numSamples)
+    {
+        switch (accuracy)
+        {
+            case SaturationAccuracy::Fast: processLanes<SaturationAccuracy::Fast>(lanes, numSamples); break;
+            case SaturationAccuracy::High: processLanes<SaturationAccuracy::High>(lanes, numSamples); break;
+            default:                       processLanes<SaturationAccuracy::Exact>(lanes, numSamples); break;
+        }
+    }
+
+    float getMaxDelayMs() const { return maxDelayMs; }
+
+private:
+    using LaneArray = std::array<float, Lanes>;
+
+    enum Smoothed
+    {
+        DelayTime, Feedback, Mix,
+        InputGain, OutputGain,
+        ModDepth, Drive,
+        NumSmoothed
+    };
+
+    // As DelayEngine's
+    static constexpr std::array<float, NumSmoothed> smoothingTimesMs = {
+        100.0f, 20.0f, 20.0f,
+        20.0f, 20.0f,
+        50.0f, 20.0f
+    };
+
+    // Lane-interleaved block buffers, chunkFrames frames each
+    enum Scratch
+    {
+        Io, Dry,
+        Delay, Wet,
+        FeedbackOut, WriteIn,
+        NumScratch
+    };
+
+    static constexpr int chunkFrames = 256;
+    static constexpr int guardFrames = Interpolation::Hermite::taps - 1;
+
+    // LinearSmoother with one ramp per lane, rendered lane-interleaved
+    struct LaneRamp
+    {
+        LaneArray current {};
+        LaneArray target {};
+        LaneArray step {};
+        std::array<int, Lanes> countdown {};
+        int remaining = 0;    // Longest countdown; 0 when every lane is idle
+        bool filled = false;  // Buffer holds current for a whole chunk
+        int rampSamples = 1;
+
+        bool isMoving() const { return remaining > 0; }
+
+        void snapTo(size_t lane, float value)
+        {
+            current[lane] = value;
+            target[lane] = value;
+            countdown[lane] = 0;
+            filled = false;
+        }
+
+        void setTarget(size_t lane, float newTarget)
+        {
+            if (newTarget == target[lane])
+                return;
+
+            target[lane] = newTarget;
+            countdown[lane] = rampSamples;
+            step[lane] = (target[lane] - current[lane]) / static_cast<float>(rampSamples);
+            remaining = rampSamples;
+            filled = false;
+        }
+
+        // Same sequence per lane as LinearSmoother::getNextValue(). Idle
+        // ramps fill the buffer once and leave it alone.
+        void render(float* dest, int numFrames)
+        {
+            if (remaining == 0)
+            {
+                if (!filled)
+                {
+                    for (int i = 0; i < chunkFrames; ++i)
+                        std::copy(current.begin(), current.end(), dest + i * Lanes);
+                    filled = true;
+                }
+                return;
+            }
+
+            for (int i = 0; i < numFrames; ++i)
+            {
+                for (int l = 0; l < Lanes; ++l)
+                {
+                    int count = countdown[l];
+                    float stepped = count > 1 ? current[l] + step[l] : target[l];
+                    current[l] = count > 0 ? stepped : current[l];
+                    countdown[l] = count > 0 ? count - 1 : 0;
+                    dest[i * Lanes + l] = current[l];
+                }
+            }
+
+            remaining = std::max(remaining - numFrames, 0);
+            filled = false;
+        }
+    };
+
+    template <SaturationAccuracy tier>
+    void processLanes(float* const* lanes, int numSamples)
+    {
+        float* io = scratch[Io];
+
+        for (int pos = 0; pos < numSamples; pos += chunkFrames)
+        {
+            const int chunk = std::min(numSamples - pos, chunkFrames);
+
+            // Bound from the ramp end points, before they advance
+            const int maxSubBlock = getMaxSubBlockLength();
+            const bool modActive = isActive(ModDepth);
+            const bool driveActive = isActive(Drive);
+
+            for (size_t k = 0; k < NumSmoothed; ++k)
+                ramps[k].render(rampBuffers[k], chunk);
+
+            for (int l = 0; l < Lanes; ++l)
+            {
+                const float* src = lanes[l] + pos;
+                for (int i = 0; i < chunk; ++i)
+                    io[i * Lanes + l] = src[i];
+            }
+
+            for (int offset = 0; offset < chunk;)
+            {
+                int len = std::min(chunk - offset, maxSubBlock);
+                processSubBlock<tier>(offset, len, modActive, driveActive);
+                offset += len;
+            }
+
+            for (int l = 0; l < Lanes; ++l)
+            {
+                float* dest = lanes[l] + pos;
+                for (int i = 0; i < chunk; ++i)
+                    dest[i] = io[i * Lanes + l];
+            }
+        }
+    }
+
+    template <SaturationAccuracy tier>
+    void processSubBlock(int offset, int numFrames, bool modActive, bool driveActive)
+    {
+        const size_t base = static_cast<size_t>(offset) * Lanes;
+        const int n = numFrames * Lanes;
+
+        float* io = scratch[Io] + base;
+        float* dry = scratch[Dry] + base;
+        float* delay = scratch[Delay] + base;
+        float* wet = scratch[Wet] + base;
+        float* fb = scratch[FeedbackOut] + base;
+        float* write = scratch[WriteIn] + base;
+
+        const float* inputGain = rampBuffers[InputGain] + base;
+        const float* delayTime = rampBuffers[DelayTime] + base;
+        const float* modDepth = rampBuffers[ModDepth] + base;
+        const float* drive = rampBuffers[Drive] + base;
+        const float* feedback = rampBuffers[Feedback] + base;
+        const float* mix = rampBuffers[Mix] + base;
+        const float* outputGain = rampBuffers[OutputGain] + base;
+
+        for (int k = 0; k < n; ++k)
+            dry[k] = io[k] * inputGain[k];
+
+        // LFO: phase before each step, then the sine of it
+        LaneArray lfoPhase = phase;
+        for (int i = 0; i < numFrames; ++i)
+        {
+            for (int l = 0; l < Lanes; ++l)
+            {
+                delay[i * Lanes + l] = lfoPhase[l];
+                float next = lfoPhase[l] + phaseIncrement[l];
+                lfoPhase[l] = next >= 1.0f ? next - 1.0f : next;
+            }
+        }
+        phase = lfoPhase;
+
+        // Modulated delay times, in samples
+        const float rate = sampleRate;
+        const float maxDelay = maxDelayMs;
+        if (modActive)
+        {
+            // Offset in its own pass, so the add below rounds the same as
+            // DelayEngine even where the compiler fuses multiply-adds
+            for (int k = 0; k < n; ++k)
+                delay[k] = ModulationLFO::sineAt(delay[k]) * modDepth[k] * 20.0f;  // +/- 20ms max
+
+            for (int k = 0; k < n; ++k)
+                delay[k] = std::clamp(delayTime[k] + delay[k], 1.0f, maxDelay) * rate / 1000.0f;
+        }
+        else
+        {
+            for (int k = 0; k < n; ++k)
+                delay[k] = std::clamp(delayTime[k], 1.0f, maxDelay) * rate / 1000.0f;
+        }
+
+        // Delay read; nothing in this sub-block has been written yet, so
+        // frame i reads as if i + 1 frames were
+        const float* buffer = ring;
+        const int ringFrames = capacity;
+        const int ringMask = mask;
+        for (int i = 0; i < numFrames; ++i)
+        {
+            const int writePos = writeIndex + i + 1;
+            for (int l = 0; l < Lanes; ++l)
+            {
+                float d = delay[i * Lanes + l];
+                int whole = static_cast<int>(d);
+                float frac = 1.0f - (d - static_cast<float>(whole));
+
+                int start = (writePos - whole - 1 - Interpolation::Hermite::before + ringFrames) & ringMask;
+                const float* y = buffer + static_cast<size_t>(start) * Lanes + l;
+
+                wet[i * Lanes + l] = Interpolation::hermite(y[0], y[Lanes], y[2 * Lanes], y[3 * Lanes], frac);
+            }
+        }
+
+        // Drive, as FeedbackProcessor: zero drive passes the signal through
+        if (driveActive)
+        {
+            for (int k = 0; k < n; ++k)
+            {
+                float amount = std::max(drive[k], 0.0f);
+                float saturated = FastMath::tanh<tier>(wet[k] * (1.0f + amount * 4.0f));
+                float driven = wet[k] * (1.0f - amount) + saturated * amount;
+                fb[k] = drive[k] <= 0.0f ? wet[k] : driven;
+            }
+        }
+        else
+        {
+            std::copy(wet, wet + n, fb);
+        }
+
+        filterAndDamp(fb, numFrames);
+
+        // Write input + previous frame's feedback, soft limited
+        for (int l = 0; l < Lanes; ++l)
+            write[l] = dry[l] + feedbackSample[l] * feedback[l];
+        for (int k = Lanes; k < n; ++k)
+            write[k] = dry[k] + fb[k - Lanes] * feedback[k];
+
+        std::copy(fb + n - Lanes, fb + n, feedbackSample.begin());
+        FastMath::softClipBlock<tier>(write, write, n);
+        writeFrames(write, numFrames);
+
+        for (int k = 0; k < n; ++k)
+        {
+            float out = dry[k] * (1.0f - mix[k]) + wet[k] * mix[k];
+            io[k] = out * outputGain[k];
+        }
+    }
+
+    // SVF and damping of FeedbackProcessor, every lane per step
+    void filterAndDamp(float* data, int numFrames)
+    {
+        LaneArray s1 = ic1eq, s2 = ic2eq, damp = dampState;
+
+        for (int i = 0; i < numFrames; ++i)
+        {
+            float* frame = data + i * Lanes;
+            for (int l = 0; l < Lanes; ++l)
+            {
+                float input = frame[l];
+                float v3 = input - s2[l];
+                float v1 = a1[l] * s1[l] + a2[l] * v3;
+                float v2 = s2[l] + a2[l] * s1[l] + a3[l] * v3;
+
+                s1[l] = 2.0f * v1 - s1[l];
+                s2[l] = 2.0f * v2 - s2[l];
+
+                float highPass = input - highPassK[l] * v1 - v2;
+                float filtered = filterMode[l] == static_cast<int>(FilterMode::HighPass) ? highPass : v2;
+                filtered = filterMode[l] == static_cast<int>(FilterMode::BandPass) ? v1 : filtered;
+
+                damp[l] += dampCoeff[l] * (filtered - damp[l]);
+                frame[l] = damp[l];
+            }
+        }
+
+        ic1eq = s1;
+        ic2eq = s2;
+        dampState = damp;
+    }
+
+    // Frames into the ring; the first guardFrames are mirrored past the end
+    // (see DelayLine)
+    void writeFrames(const float* frames, int numFrames)
+    {
+        int i = 0;
+        while (i < numFrames)
+        {
+            int run = std::min(numFrames - i, capacity - writeIndex);
+            const float* src = frames + static_cast<size_t>(i) * Lanes;
+            std::copy(src, src + run * Lanes, ring + static_cast<size_t>(writeIndex) * Lanes);
+
+            if (writeIndex < guardFrames)
+            {
+                int mirrored = std::min(run, guardFrames - writeIndex);
+                std::copy(src, src + mirrored * Lanes, ring + static_cast<size_t>(capacity + writeIndex) * Lanes);
+            }
+
+            writeIndex = (writeIndex + run) & mask;
+            i += run;
+        }
+    }
+
+    // Some lane is moving or non-zero
+    bool isActive(Smoothed which) const
+    {
+        const auto& r = ramps[which];
+        return r.isMoving() || std::any_of(r.current.begin(), r.current.end(), [](float x) { return x != 0.0f; });
+    }
+
+    // Longest sub-block whose reads all precede its writes, over every lane
+    // (see DelayEngine::getMaxSubBlockLength())
+    int getMaxSubBlockLength() const
+    {
+        int minDelaySamples = capacity;
+
+        for (int l = 0; l < Lanes; ++l)
+        {
+            float minDelayMs = std::min(ramps[DelayTime].current[l], ramps[DelayTime].target[l]);
+            float maxModDepth = std::max(std::abs(ramps[ModDepth].current[l]), std::abs(ramps[ModDepth].target[l]));
+
+            minDelayMs = std::clamp(minDelayMs - maxModDepth * 20.0f, 1.0f, maxDelayMs);
+            minDelaySamples = std::min(minDelaySamples, static_cast<int>(minDelayMs * sampleRate / 1000.0f));
+        }
+
+        return std::max(minDelaySamples - Interpolation::Hermite::lookahead, 1);
+    }
+
+    float sampleRate = 44100.0f;
+    float maxDelayMs = 2000.0f;
+    SaturationAccuracy accuracy = SaturationAccuracy::Exact;
+
+    // Owns the ring and every block buffer
+    BufferArena arena;
+    std::array<float*, NumScratch> scratch {};
+    std::array<float*, NumSmoothed> rampBuffers {};
+
+    // Lane-interleaved delay ring
+    float* ring = nullptr;
+    int capacity = 0;
+    int mask = 0;
+    int writeIndex = 0;
+
+    // Parameter ramps; a lane snaps on its first setParameters()
+    std::array<LaneRamp, NumSmoothed> ramps;
+    std::array<bool, Lanes> snapLane {};
+
+    // LFO
+    LaneArray phase {};
+    LaneArray phaseIncrement {};
+
+    // Feedback filter and damping coefficients, and their state
+    std::array<FeedbackCoefficientCache, Lanes> coefficientCaches;
+    LaneArray a1 {}, a2 {}, a3 {}, highPassK {}, dampCoeff {};
+    std::array<int, Lanes> filterMode {};
+    LaneArray ic1eq {}, ic2eq {}, dampState {};
+    LaneArray feedbackSample {};
+};
+
+} // namespace Chronos
@@ -1,14 +1,30 @@
 #pragma once
 
+#include "Interpolation.h"
 #include <vector>
 #include <cmath>
 #include <algorithm>
 
 namespace Chronos {
 
+// Smallest power of two >= n, so ring buffer indices wrap with a mask
+inline int nextPowerOfTwo(int n)
+{
+    int p = 1;
+    while (p < n)
+        p <<= 1;
+    return p;
+}
+
+// Mono ring buffer with power-of-two capacity. The first guardSamples are
+// mirrored past the end, so every interpolation window is one contiguous run
+// of memory and indices wrap with a mask instead of a modulo.
 class DelayLine
 {
 public:
+    // Samples mirrored past the end so the widest interpolation window fits
+    static constexpr int guardSamples = Interpolation::maxTaps - 1;
+
     DelayLine() = default;
 
     void prepare(float sampleRate, float maxDelayMs)
@@ -18,7 +34,9 @@ public:
 
         // Calculate buffer size with some headroom
         int maxSamples = static_cast<int>(std::ceil(maxDelayMs * sampleRate / 1000.0f)) + 4;
-        buffer.resize(static_cast<size_t>(maxSamples), 0.0f);
+        capacity = nextPowerOfTwo(maxSamples);
+        mask = capacity - 1;
+        buffer.assign(static_cast<size_t>(capacity + guardSamples), 0.0f);
         writeIndex = 0;
     }
 
@@ -31,50 +49,48 @@ public:
     void write(float sample)
     {
         buffer[static_cast<size_t>(writeIndex)] = sample;
-        writeIndex = (writeIndex + 1) % static_cast<int>(buffer.size());
+        if (writeIndex < guardSamples)
+            buffer[static_cast<size_t>(capacity + writeIndex)] = sample;
+
+        writeIndex = (writeIndex + 1) & mask;
+    }
+
+    void writeBlock(const float* samples, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            write(samples[i]);
     }
 
     // Linear interpolation - efficient for non-modulated delay
     float readLinear(float delayInSamples) const
     {
-        float readPos = static_cast<float>(writeIndex) - delayInSamples;
-        while (readPos < 0.0f)
-            readPos += static_cast<float>(buffer.size());
-
-        int index0 = static_cast<int>(readPos);
-        int index1 = (index0 + 1) % static_cast<int>(buffer.size());
-        float frac = readPos - static_cast<float>(index0);
-
-        return buffer[static_cast<size_t>(index0)] * (1.0f - frac) +
-               buffer[static_cast<size_t>(index1)] * frac;
+        Interpolation::Linear::State state;
+        return read<Interpolation::Linear>(delayInSamples, 0, state);
     }
 
     // Cubic interpolation - smooth for modulated delay (prevents aliasing)
     float read(float delayInSamples) const
     {
-        float readPos = static_cast<float>(writeIndex) - delayInSamples;
-        while (readPos < 0.0f)
-            readPos += static_cast<float>(buffer.size());
-
-        int index1 = static_cast<int>(readPos);
-        int index0 = (index1 - 1 + static_cast<int>(buffer.size())) % static_cast<int>(buffer.size());
-        int index2 = (index1 + 1) % static_cast<int>(buffer.size());
-        int index3 = (index1 + 2) % static_cast<int>(buffer.size());
-
-        float frac = readPos - static_cast<float>(index1);
+        return read(delayInSamples, 0);
+    }
 
-        float y0 = buffer[static_cast<size_t>(index0)];
-        float y1 = buffer[static_cast<size_t>(index1)];
-        float y2 = buffer[static_cast<size_t>(index2)];
-        float y3 = buffer[static_cast<size_t>(index3)];
+    // Cubic read as if writeAhead more samples had already been written.
+    // The block engine reads a whole sub-block before writing it, so sample i
+    // of the sub-block reads with writeAhead = i + 1.
+    float read(float delayInSamples, int writeAhead) const
+    {
+        Interpolation::Hermite::State state;
+        return read<Interpolation::Hermite>(delayInSamples, writeAhead, state);
+    }
 
-        // Cubic Hermite interpolation
-        float c0 = y1;
-        float c1 = 0.5f * (y2 - y0);
-        float c2 = y0 - 2.5f * y1 + 2.0f * y2 - 0.5f * y3;
-        float c3 = 0.5f * (y3 - y0) + 1.5f * (y1 - y2);
+    // Read with any interpolation policy from Interpolation.h
+    template <typename Interp>
+    float read(float delayInSamples, int writeAhead, typename Interp::State& state) const
+    {
+        float frac;
+        const float* y = window<Interp>((writeIndex + writeAhead) & mask, delayInSamples, frac);
 
-        return ((c3 * frac + c2) * frac + c1) * frac + c0;
+        return Interp::process(y, 1, frac, state);
     }
 
     float msToSamples(float ms) const
@@ -86,7 +102,22 @@ public:
     float getSampleRate() const { return sampleRate; }
 
 private:
+    // Returns the start of the policy's window around writePos - delay; frac
+    // is the position between index1 and index1 + 1. Splitting the delay into
+    // whole and fractional parts keeps full fractional precision at any index.
+    template <typename Interp>
+    const float* window(int writePos, float delayInSamples, float& frac) const
+    {
+        int whole = static_cast<int>(delayInSamples);
+        frac = 1.0f - (delayInSamples - static_cast<float>(whole));
+
+        int start = (writePos - whole - 1 - Interp::before + capacity) & mask;
+        return buffer.data() + start;
+    }
+
     std::vector<float> buffer;
+    int capacity = 0;
+    int mask = 0;
     int writeIndex = 0;
     float sampleRate = 44100.0f;
     float maxDelayMs = 2000.0f;
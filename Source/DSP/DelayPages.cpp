@@ -0,0 +1,4 @@
+#include "DelayPages.h"
+
+// Implementation is header-only for inline performance
+// This file exists for build system compatibility
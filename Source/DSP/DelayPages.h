@@ -0,0 +1,346 @@
+#pragma once
+
+#include "DelayLine.h"
+#include "BufferArena.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <vector>
+#include <algorithm>
+
+namespace Chronos {
+
+// Page storage for MultiChannelDelayLine's interleaved ring buffer. A page
+// holds pageFrames frames of numChannels values each.
+//
+// Only a sliding window of pages is committed: the page being written, the
+// page after it, and as many pages behind the writer as the current delay
+// needs (setRequiredFrames()). Every other page maps to one shared zero page,
+// so reads beyond the retained history are silent. Memory follows the delay
+// time in use rather than the maximum.
+//
+// The audio thread never allocates or frees. When the writer enters a page
+// it commits the next one from a pool and retires surplus history pages;
+// service() refills the pool and frees retired pages on another thread. The
+// two hand-offs are single-producer/single-consumer queues. If the pool runs
+// dry the oldest page is reused, which shortens the history but never blocks.
+//
+// Each page carries guardFrames past its end that mirror the start of the
+// next page, so an interpolation window is always one contiguous load. Pages
+// are 64-byte aligned and prefaulted when allocated, so the audio thread's
+// first write to a page does not fault.
+template <typename T>
+class DelayPages
+{
+public:
+    static constexpr int pageShift = 12;
+    static constexpr int pageFrames = 1 << pageShift;  // 85 ms at 48 kHz
+    static constexpr int guardFrames = DelayLine::guardSamples;
+    static constexpr int maxChannels = 16;  // 9.1.6
+
+    DelayPages() = default;
+    ~DelayPages() { releaseAll(); }
+
+    DelayPages(const DelayPages&) = delete;
+    DelayPages& operator=(const DelayPages&) = delete;
+
+    // Ring of at least capacityFrames (rounded up to a power of two with room
+    // for the writer's and the look-ahead page). Not realtime safe; throws
+    // std::bad_alloc if the two pages the writer starts on cannot be had.
+    int prepare(int capacityFrames, int numChannels)
+    {
+        std::lock_guard<std::mutex> lock(serviceLock);
+        releaseAll();
+
+        channels = std::clamp(numChannels, 1, maxChannels);
+        pageValues = static_cast<size_t>(pageFrames + guardFrames) * static_cast<size_t>(channels);
+
+        numPages = nextPowerOfTwo((capacityFrames + 3 * pageFrames - 1) >> pageShift);
+        pageMask = numPages - 1;
+        table.assign(static_cast<size_t>(numPages), zeroPage());
+        pool.reset(static_cast<size_t>(numPages));
+        retired.reset(static_cast<size_t>(numPages));
+
+        // The writer starts at frame 0 and its first write commits page 1.
+        // The page before it is committed too, so windows reaching back past
+        // frame 0 read a real (silent) page and its guard.
+        try
+        {
+            table[0] = allocatePage();
+            table[static_cast<size_t>(pageMask)] = allocatePage();
+        }
+        catch (const std::bad_alloc&)
+        {
+            // Left unprepared, so service() has nothing to refill
+            releaseAll();
+            numPages = 0;
+            throw;
+        }
+
+        tail = pageMask;
+        committed = 2;
+        committedCount.store(committed, std::memory_order_release);
+        target.store(std::clamp(target.load(std::memory_order_relaxed), 2, numPages - 1), std::memory_order_relaxed);
+        fillPool();
+
+        return numPages << pageShift;
+    }
+
+    // Frees every page (storage not in use). Not realtime safe.
+    void release()
+    {
+        std::lock_guard<std::mutex> lock(serviceLock);
+        releaseAll();
+        numPages = 0;
+    }
+
+    // Zeroes the committed pages; the window is kept
+    void clear()
+    {
+        for (T* page : table)
+        {
+            if (page != zeroPage())
+                std::fill(page, page + pageValues, T {});
+        }
+    }
+
+    // Frames of history to keep behind the writer. Audio thread.
+    void setRequiredFrames(int frames)
+    {
+        int pages = (std::max(frames, 0) + pageFrames - 1) / pageFrames + 2;
+        target.store(std::clamp(pages, 2, numPages - 1), std::memory_order_relaxed);
+    }
+
+    // Refills the pool toward the target and frees retired pages. Call
+    // periodically from a non-realtime thread (or the render thread offline).
+    void service()
+    {
+        std::lock_guard<std::mutex> lock(serviceLock);
+        if (numPages > 0)
+            fillPool();
+    }
+
+    // Frame pointer for reads; uncommitted pages read as silence
+    const T* frame(int index) const
+    {
+        return table[static_cast<size_t>(index >> pageShift)] + static_cast<size_t>(index & offsetMask) * static_cast<size_t>(channels);
+    }
+
+    // Start of a write run at index (up to the page end). Entering a page
+    // commits the one after it.
+    T* beginWrite(int index)
+    {
+        if ((index & offsetMask) == 0)
+            advance(index >> pageShift);
+
+        return table[static_cast<size_t>(index >> pageShift)] + static_cast<size_t>(index & offsetMask) * static_cast<size_t>(channels);
+    }
+
+    // Mirrors the start of a run written at index into the previous page's guard
+    void endWrite(int index, int numFrames)
+    {
+        const int offset = index & offsetMask;
+        if (offset >= guardFrames)
+            return;
+
+        T* previous = table[static_cast<size_t>(((index >> pageShift) - 1) & pageMask)];
+        if (previous == zeroPage())
+            return;
+
+        const T* src = frame(index);
+        const int count = std::min(numFrames, guardFrames - offset);
+        std::copy(src, src + count * channels, previous + static_cast<size_t>((pageFrames + offset) * channels));
+    }
+
+    int getCapacity() const { return numPages << pageShift; }
+
+    // Committed plus pooled bytes (approximate while service() runs)
+    size_t getMemoryBytes() const
+    {
+        size_t pages = static_cast<size_t>(committedCount.load(std::memory_order_relaxed)) + pool.size();
+        return pages * pageValues * sizeof(T);
+    }
+
+private:
+    static constexpr int offsetMask = pageFrames - 1;
+
+    // Fixed-capacity single-producer/single-consumer queue of pages
+    class PageQueue
+    {
+    public:
+        void reset(size_t capacity)
+        {
+            slots.assign(capacity + 1, nullptr);
+            head.store(0, std::memory_order_relaxed);
+            tail.store(0, std::memory_order_relaxed);
+        }
+
+        bool push(T* page)
+        {
+            size_t h = head.load(std::memory_order_relaxed);
+            size_t next = h + 1 == slots.size() ? 0 : h + 1;
+            if (next == tail.load(std::memory_order_acquire))
+                return false;
+
+            slots[h] = page;
+            head.store(next, std::memory_order_release);
+            return true;
+        }
+
+        T* pop()
+        {
+            size_t t = tail.load(std::memory_order_relaxed);
+            if (t == head.load(std::memory_order_acquire))
+                return nullptr;
+
+            T* page = slots[t];
+            tail.store(t + 1 == slots.size() ? 0 : t + 1, std::memory_order_release);
+            return page;
+        }
+
+        size_t size() const
+        {
+            size_t h = head.load(std::memory_order_acquire);
+            size_t t = tail.load(std::memory_order_acquire);
+            return h >= t ? h - t : h + slots.size() - t;
+        }
+
+    private:
+        std::vector<T*> slots;
+        std::atomic<size_t> head { 0 };
+        std::atomic<size_t> tail { 0 };
+    };
+
+    // Writer moved onto page: retire surplus history, then commit the next
+    // page from the pool, or by reusing the oldest page in steady state
+    void advance(int page)
+    {
+        const int wanted = target.load(std::memory_order_relaxed);
+
+        // The window holds at least [page - 1, page] here, and wanted >= 2
+        while (committed > wanted)
+            retired.push(takeTail());
+
+        // Pool pages beyond what the target still needs go back too
+        while (static_cast<int>(pool.size()) > wanted - committed + spareCount)
+        {
+            T* spare = pool.pop();
+            if (spare == nullptr)
+                break;
+            retired.push(spare);
+        }
+
+        T* fresh = committed < wanted ? pool.pop() : nullptr;
+        if (fresh == nullptr)
+        {
+            fresh = takeTail();
+            std::fill(fresh, fresh + pageValues, T {});
+        }
+
+        table[static_cast<size_t>((page + 1) & pageMask)] = fresh;
+        ++committed;
+        committedCount.store(committed, std::memory_order_release);
+    }
+
+    T* takeTail()
+    {
+        T* page = table[static_cast<size_t>(tail)];
+        table[static_cast<size_t>(tail)] = zeroPage();
+        tail = (tail + 1) & pageMask;
+        --committed;
+        return page;
+    }
+
+    // Caller holds serviceLock (or owns the audio thread, in prepare())
+    void fillPool()
+    {
+        const int wanted = target.load(std::memory_order_relaxed) + spareCount;
+        int have = committedCount.load(std::memory_order_acquire) + static_cast<int>(pool.size());
+
+        // Retired pages are reused before allocating
+        while (T* page = retired.pop())
+        {
+            if (have < wanted)
+            {
+                std::fill(page, page + pageValues, T {});
+                pool.push(page);
+                ++have;
+            }
+            else
+            {
+                freePage(page);
+            }
+        }
+
+        // Out of memory: the pool stays short and the writer reuses its
+        // oldest page, which shortens the history rather than failing
+        try
+        {
+            for (; have < wanted; ++have)
+                pool.push(allocatePage());
+        }
+        catch (const std::bad_alloc&)
+        {
+        }
+    }
+
+    // Throws std::bad_alloc
+    T* allocatePage() const
+    {
+        const size_t bytes = pageValues * sizeof(T);
+        void* page = AlignedMemory::allocate(bytes);
+        AlignedMemory::prefault(page, bytes);
+        return static_cast<T*>(page);
+    }
+
+    static void freePage(T* page)
+    {
+        AlignedMemory::release(page);
+    }
+
+    // Shared read-only silence for uncommitted pages, sized for the widest
+    // layout; never written, since writes only reach the writer's page and
+    // committed guards
+    static T* zeroPage()
+    {
+        static std::array<T, static_cast<size_t>(pageFrames + guardFrames) * maxChannels> zeros {};
+        return zeros.data();
+    }
+
+    void releaseAll()
+    {
+        for (T* page : table)
+        {
+            if (page != zeroPage())
+                freePage(page);
+        }
+        table.clear();
+
+        while (T* page = pool.pop())
+            freePage(page);
+        while (T* page = retired.pop())
+            freePage(page);
+
+        committed = 0;
+        committedCount.store(0, std::memory_order_release);
+    }
+
+    static constexpr int spareCount = 1;  // Pooled ahead of need
+
+    std::vector<T*> table;  // One entry per page; zeroPage() when uncommitted
+    PageQueue pool;         // service() -> audio thread, zeroed
+    PageQueue retired;      // Audio thread -> service()
+    std::mutex serviceLock;
+
+    int numPages = 0;
+    int pageMask = 0;
+    int channels = 1;
+    size_t pageValues = 0;  // Page plus guard, all channels
+    int tail = 0;       // Oldest committed page
+    int committed = 0;  // Window is [tail, writer page + 1]
+    std::atomic<int> committedCount { 0 };
+    std::atomic<int> target { 2 };
+};
+
+} // namespace Chronos
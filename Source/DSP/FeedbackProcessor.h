@@ -1,5 +1,7 @@
 #pragma once
 
+#include "FastMath.h"
+#include "Oversampler.h"
 #include <cmath>
 #include <algorithm>
 
@@ -12,14 +14,105 @@ enum class FilterMode
     BandPass
 };
 
+// Filter and damping coefficients for FeedbackProcessor. Both channels use
+// the same settings, so the engine computes one set and shares it.
+struct FeedbackCoefficients
+{
+    // SVF (Cytomic/Andrew Simper method)
+    float a1 = 0.0f, a2 = 0.0f, a3 = 0.0f;
+    float resonance = 0.0f;
+    FilterMode mode = FilterMode::LowPass;
+
+    // Damping (1-pole LP)
+    float dampCoeff = 0.1f;
+};
+
+// Recomputes FeedbackCoefficients only when their inputs change, so the
+// tan/exp calls run on parameter changes rather than on every block.
+class FeedbackCoefficientCache
+{
+public:
+    void prepare(float sampleRate)
+    {
+        this->sampleRate = sampleRate;
+        filterValid = false;
+        dampingValid = false;
+    }
+
+    // Returns true if the coefficients changed
+    bool update(float frequencyHz, float resonance, FilterMode mode, float damping)
+    {
+        frequencyHz = std::clamp(frequencyHz, 20.0f, 20000.0f);
+        resonance = std::clamp(resonance, 0.0f, 1.0f);
+        damping = std::clamp(damping, 0.0f, 1.0f);
+
+        bool changed = false;
+
+        if (!filterValid || frequencyHz != cutoffHz || resonance != coeffs.resonance)
+        {
+            cutoffHz = frequencyHz;
+            coeffs.resonance = resonance;
+
+            float g = std::tan(3.14159265359f * cutoffHz / sampleRate);
+            float k = 2.0f - 2.0f * resonance;  // Q = 1/(2-2*res), so k = 2-2*res
+
+            coeffs.a1 = 1.0f / (1.0f + g * (g + k));
+            coeffs.a2 = g * coeffs.a1;
+            coeffs.a3 = g * coeffs.a2;
+
+            filterValid = true;
+            changed = true;
+            ++recomputeCount;
+        }
+
+        if (mode != coeffs.mode)
+        {
+            coeffs.mode = mode;
+            changed = true;
+        }
+
+        if (!dampingValid || damping != dampingAmount)
+        {
+            // Damping: 0 = no HF rolloff, 1 = heavy rolloff
+            // Maps to a simple 1-pole lowpass coefficient
+            dampingAmount = damping;
+            // Higher damping = lower cutoff
+            float dampFreq = 20000.0f * (1.0f - dampingAmount * 0.95f);
+            float x = std::exp(-2.0f * 3.14159265359f * dampFreq / sampleRate);
+            coeffs.dampCoeff = 1.0f - x;
+
+            dampingValid = true;
+            changed = true;
+            ++recomputeCount;
+        }
+
+        return changed;
+    }
+
+    const FeedbackCoefficients& get() const { return coeffs; }
+
+    // Debug counter: number of transcendental recomputes since construction
+    int getRecomputeCount() const { return recomputeCount; }
+
+private:
+    float sampleRate = 44100.0f;
+    FeedbackCoefficients coeffs;
+    float cutoffHz = 8000.0f;
+    float dampingAmount = 0.0f;
+    bool filterValid = false;
+    bool dampingValid = false;
+    int recomputeCount = 0;
+};
+
 class FeedbackProcessor
 {
 public:
     FeedbackProcessor() = default;
 
-    void prepare(float sampleRate)
+    void prepare(float sampleRate, int maxBlockSize, BufferArena& arena)
     {
-        this->sampleRate = sampleRate;
+        cache.prepare(sampleRate);
+        oversampler.prepare(maxBlockSize, arena);
         reset();
     }
 
@@ -31,68 +124,173 @@ public:
 
         // Damping filter state
         dampState = 0.0f;
+
+        oversampler.reset();
     }
 
     void setFilterParams(float frequencyHz, float resonance, FilterMode mode)
     {
-        cutoffHz = std::clamp(frequencyHz, 20.0f, 20000.0f);
-        this->resonance = std::clamp(resonance, 0.0f, 1.0f);
+        filterFreq = frequencyHz;
+        filterRes = resonance;
         filterMode = mode;
-        updateCoefficients();
+        if (cache.update(filterFreq, filterRes, filterMode, dampingAmount))
+            coeffs = cache.get();
     }
 
     void setDamping(float damping)
     {
-        // Damping: 0 = no HF rolloff, 1 = heavy rolloff
-        // Maps to a simple 1-pole lowpass coefficient
-        dampingAmount = std::clamp(damping, 0.0f, 1.0f);
-        // Higher damping = lower cutoff
-        float dampFreq = 20000.0f * (1.0f - dampingAmount * 0.95f);
-        float x = std::exp(-2.0f * 3.14159265359f * dampFreq / sampleRate);
-        dampCoeff = 1.0f - x;
+        dampingAmount = damping;
+        if (cache.update(filterFreq, filterRes, filterMode, dampingAmount))
+            coeffs = cache.get();
+    }
+
+    // Use coefficients computed elsewhere (shared between channels)
+    void setCoefficients(const FeedbackCoefficients& newCoeffs)
+    {
+        coeffs = newCoeffs;
+    }
+
+    // Automatic is resolved by the caller; treated as Exact here
+    void setSaturationAccuracy(SaturationAccuracy newAccuracy)
+    {
+        accuracy = newAccuracy;
+    }
+
+    // Saturation oversampling factor (1, 2 or 4)
+    void setOversampling(int factor)
+    {
+        oversampler.setFactor(factor);
+    }
+
+    // The owner turns oversampling off while drive is 0 (saturation is then
+    // the identity, so there is nothing to alias)
+    void setOversamplingEnabled(bool enabled)
+    {
+        oversampler.setEnabled(enabled);
+    }
+
+    // Latency of the saturation stage at sample i of the next block, in
+    // samples (see Oversampler::getLatencyAt)
+    float getLatencyAt(int i) const
+    {
+        return oversampler.getLatencyAt(i);
+    }
+
+    bool isLatencyChanging() const
+    {
+        return oversampler.isLatencyChanging();
+    }
+
+    // Most it can be at the current oversampling factor
+    float getMaxLatency() const
+    {
+        return oversampler.getLatencySamples();
     }
 
     float process(float input, float drive)
     {
         // Apply drive/saturation first
-        float driven = applySaturation(input, drive);
+        float driven;
+        saturate(&input, &driven, 1, drive);
 
         // Apply SVF filter
         float filtered = processFilter(driven);
 
         // Apply damping (simple 1-pole LP)
-        dampState += dampCoeff * (filtered - dampState);
+        dampState += coeffs.dampCoeff * (filtered - dampState);
 
         return dampState;
     }
 
+    // Block version of process(): saturation, filter and damping each run as
+    // their own loop so the stateless saturation stage can vectorize.
+    void processBlock(const float* input, float* output, int numSamples, float drive)
+    {
+        saturate(input, output, numSamples, drive);
+        filterAndDampBlock(output, numSamples);
+    }
+
+    // As above, with a per-sample drive ramp
+    void processBlock(const float* input, float* output, int numSamples, const float* drive)
+    {
+        oversampler.process(input, output, numSamples,
+                            [this, drive](const float* in, float* out, int len, int shift) {
+                                saturateBlock(in, out, len, [drive, shift](int i) { return drive[i >> shift]; });
+                            });
+
+        filterAndDampBlock(output, numSamples);
+    }
+
 private:
-    void updateCoefficients()
+    // Saturation stage, oversampled when enabled
+    void saturate(const float* input, float* output, int numSamples, float drive)
     {
-        // SVF coefficients (Cytomic/Andrew Simper method)
-        float g = std::tan(3.14159265359f * cutoffHz / sampleRate);
-        float k = 2.0f - 2.0f * resonance;  // Q = 1/(2-2*res), so k = 2-2*res
+        oversampler.process(input, output, numSamples,
+                            [this, drive](const float* in, float* out, int len, int) {
+                                if (drive <= 0.0f)
+                                    std::copy(in, in + len, out);
+                                else
+                                    saturateBlock(in, out, len, [drive](int) { return drive; });
+                            });
+    }
 
-        a1 = 1.0f / (1.0f + g * (g + k));
-        a2 = g * a1;
-        a3 = g * a2;
+    template <typename DriveAt>
+    void saturateBlock(const float* input, float* output, int numSamples, DriveAt driveAt)
+    {
+        switch (accuracy)
+        {
+            case SaturationAccuracy::Fast: applySaturationBlock<SaturationAccuracy::Fast>(input, output, numSamples, driveAt); break;
+            case SaturationAccuracy::High: applySaturationBlock<SaturationAccuracy::High>(input, output, numSamples, driveAt); break;
+            default:                       applySaturationBlock<SaturationAccuracy::Exact>(input, output, numSamples, driveAt); break;
+        }
+    }
+
+    // Soft saturation, 1x to 5x gain into tanh, mixed with the dry signal by
+    // drive. Branch-free: zero drive mixes in none of the tanh term, so the
+    // output is the input exactly.
+    template <SaturationAccuracy tier, typename DriveAt>
+    static void applySaturationBlock(const float* input, float* output, int numSamples, DriveAt driveAt)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            float drive = std::max(driveAt(i), 0.0f);
+            float driveAmount = 1.0f + drive * 4.0f;
+            float saturated = FastMath::tanh<tier>(input[i] * driveAmount);
+            output[i] = input[i] * (1.0f - drive) + saturated * drive;
+        }
+    }
+
+    void filterAndDampBlock(float* output, int numSamples)
+    {
+        switch (coeffs.mode)
+        {
+            case FilterMode::LowPass:  processFilterBlock<FilterMode::LowPass>(output, numSamples);  break;
+            case FilterMode::HighPass: processFilterBlock<FilterMode::HighPass>(output, numSamples); break;
+            case FilterMode::BandPass: processFilterBlock<FilterMode::BandPass>(output, numSamples); break;
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            dampState += coeffs.dampCoeff * (output[i] - dampState);
+            output[i] = dampState;
+        }
     }
 
     float processFilter(float input)
     {
         float v3 = input - ic2eq;
-        float v1 = a1 * ic1eq + a2 * v3;
-        float v2 = ic2eq + a2 * ic1eq + a3 * v3;
+        float v1 = coeffs.a1 * ic1eq + coeffs.a2 * v3;
+        float v2 = ic2eq + coeffs.a2 * ic1eq + coeffs.a3 * v3;
 
         ic1eq = 2.0f * v1 - ic1eq;
         ic2eq = 2.0f * v2 - ic2eq;
 
-        switch (filterMode)
+        switch (coeffs.mode)
         {
             case FilterMode::LowPass:
                 return v2;
             case FilterMode::HighPass:
-                return input - (2.0f - 2.0f * resonance) * v1 - v2;
+                return input - (2.0f - 2.0f * coeffs.resonance) * v1 - v2;
             case FilterMode::BandPass:
                 return v1;
             default:
@@ -100,35 +298,46 @@ private:
         }
     }
 
-    float applySaturation(float input, float drive)
+    template <FilterMode mode>
+    void processFilterBlock(float* data, int numSamples)
     {
-        if (drive <= 0.0f)
-            return input;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            float input = data[i];
+            float v3 = input - ic2eq;
+            float v1 = coeffs.a1 * ic1eq + coeffs.a2 * v3;
+            float v2 = ic2eq + coeffs.a2 * ic1eq + coeffs.a3 * v3;
 
-        // Soft saturation using tanh
-        float driveAmount = 1.0f + drive * 4.0f;  // 1x to 5x gain into saturation
-        float saturated = std::tanh(input * driveAmount);
+            ic1eq = 2.0f * v1 - ic1eq;
+            ic2eq = 2.0f * v2 - ic2eq;
 
-        // Mix dry and saturated based on drive amount
-        return input * (1.0f - drive) + saturated * drive;
+            if constexpr (mode == FilterMode::LowPass)
+                data[i] = v2;
+            else if constexpr (mode == FilterMode::HighPass)
+                data[i] = input - (2.0f - 2.0f * coeffs.resonance) * v1 - v2;
+            else
+                data[i] = v1;
+        }
     }
 
-    float sampleRate = 44100.0f;
-
     // SVF state
     float ic1eq = 0.0f;
     float ic2eq = 0.0f;
-    float a1 = 0.0f, a2 = 0.0f, a3 = 0.0f;
-
-    // Filter params
-    float cutoffHz = 8000.0f;
-    float resonance = 0.0f;
-    FilterMode filterMode = FilterMode::LowPass;
 
-    // Damping (1-pole LP)
+    // Damping (1-pole LP) state
     float dampState = 0.0f;
-    float dampCoeff = 0.1f;
+
+    // Coefficients, and the settings they were computed from when this
+    // processor manages its own (setFilterParams/setDamping)
+    FeedbackCoefficients coeffs;
+    FeedbackCoefficientCache cache;
+    float filterFreq = 8000.0f;
+    float filterRes = 0.0f;
+    FilterMode filterMode = FilterMode::LowPass;
     float dampingAmount = 0.0f;
+
+    SaturationAccuracy accuracy = SaturationAccuracy::Exact;
+    Oversampler oversampler;
 };
 
 } // namespace Chronos
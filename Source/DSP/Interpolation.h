@@ -0,0 +1,202 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+
+namespace Chronos {
+
+enum class InterpolationMode
+{
+    Automatic,  // Engine picks the cheapest transparent policy per block
+    Integer,
+    Linear,
+    Hermite,
+    Thiran,
+    Sinc
+};
+
+// Fractional-delay interpolation policies for the delay line read templates.
+//
+// Each policy reads a window of `taps` samples starting `before` samples ahead
+// of index1, the sample just before the read position; t in (0, 1] is the
+// position between index1 and index1 + 1. `lookahead` is the newest sample
+// beyond index1 the window touches, which bounds the block engine's
+// sub-block length. Samples are `stride` floats apart (the channel count of
+// an interleaved buffer). Stateful policies (Thiran) keep one State per channel.
+namespace Interpolation {
+
+// Nearest sample. Exact when the delay is a whole number of samples.
+struct Integer
+{
+    static constexpr int taps = 2;
+    static constexpr int before = 0;
+    static constexpr int lookahead = 1;
+    struct State {};
+
+    static float process(const float* y, int stride, float t, State&)
+    {
+        return t < 0.5f ? y[0] : y[stride];
+    }
+};
+
+struct Linear
+{
+    static constexpr int taps = 2;
+    static constexpr int before = 0;
+    static constexpr int lookahead = 1;
+    struct State {};
+
+    static float process(const float* y, int stride, float t, State&)
+    {
+        return y[0] * (1.0f - t) + y[stride] * t;
+    }
+};
+
+// Cubic Hermite interpolation between y1 and y2, frac in [0, 1]
+inline float hermite(float y0, float y1, float y2, float y3, float frac)
+{
+    float c0 = y1;
+    float c1 = 0.5f * (y2 - y0);
+    float c2 = y0 - 2.5f * y1 + 2.0f * y2 - 0.5f * y3;
+    float c3 = 0.5f * (y3 - y0) + 1.5f * (y1 - y2);
+
+    return ((c3 * frac + c2) * frac + c1) * frac + c0;
+}
+
+struct Hermite
+{
+    static constexpr int taps = 4;
+    static constexpr int before = 1;
+    static constexpr int lookahead = 2;
+    struct State {};
+
+    static float process(const float* y, int stride, float t, State&)
+    {
+        return hermite(y[0], y[stride], y[2 * stride], y[3 * stride], t);
+    }
+};
+
+// First-order Thiran allpass. Flat magnitude response, so static fractional
+// delays keep their top end through every repeat. Only valid for delays that
+// do not move: the recursion assumes consecutive reads one sample apart.
+struct Thiran
+{
+    static constexpr int taps = 4;
+    static constexpr int before = 1;
+    static constexpr int lookahead = 2;
+
+    struct State
+    {
+        float lastOutput = 0.0f;
+        float lastFrac = -1.0f;
+        float coeff = 0.0f;
+    };
+
+    static float process(const float* y, int stride, float t, State& state)
+    {
+        // Keep the allpass delay D in [0.5, 1.5) by choosing which stored
+        // sample feeds it; frac is the delay past the newer of the two
+        float frac = 1.0f - t;
+        int newest = frac < 0.5f ? 3 : 2;
+
+        if (frac != state.lastFrac)
+        {
+            float d = frac < 0.5f ? frac + 1.0f : frac;
+            state.coeff = (1.0f - d) / (1.0f + d);
+            state.lastFrac = frac;
+        }
+
+        float x0 = y[newest * stride];
+        float x1 = y[(newest - 1) * stride];
+        state.lastOutput = state.coeff * (x0 - state.lastOutput) + x1;
+        return state.lastOutput;
+    }
+};
+
+// 16-tap polyphase windowed sinc (Blackman-Harris) with linear interpolation
+// between 256 phases. Used for offline renders where quality beats cost.
+struct Sinc
+{
+    static constexpr int taps = 16;
+    static constexpr int before = 7;
+    static constexpr int lookahead = 8;
+    static constexpr int phases = 256;
+    struct State {};
+
+    using Table = std::array<std::array<float, taps>, phases + 1>;
+
+    // Shared, read-only; built once on first use
+    static const Table& getTable()
+    {
+        static const Table table = buildTable();
+        return table;
+    }
+
+    static float process(const float* y, int stride, float t, State&)
+    {
+        const Table& table = getTable();
+
+        float phasePos = t * static_cast<float>(phases);
+        int phase = static_cast<int>(phasePos);
+        if (phase >= phases)
+            phase = phases - 1;
+        float phaseFrac = phasePos - static_cast<float>(phase);
+
+        const auto& k0 = table[static_cast<size_t>(phase)];
+        const auto& k1 = table[static_cast<size_t>(phase + 1)];
+
+        float acc0 = 0.0f;
+        float acc1 = 0.0f;
+        for (int k = 0; k < taps; ++k)
+        {
+            float x = y[k * stride];
+            acc0 += k0[static_cast<size_t>(k)] * x;
+            acc1 += k1[static_cast<size_t>(k)] * x;
+        }
+
+        return acc0 + (acc1 - acc0) * phaseFrac;
+    }
+
+private:
+    static Table buildTable()
+    {
+        constexpr double pi = 3.14159265358979323846;
+        constexpr double halfSpan = taps / 2.0;
+
+        Table table{};
+        for (int p = 0; p <= phases; ++p)
+        {
+            double t = static_cast<double>(p) / phases;
+            double sum = 0.0;
+            std::array<double, taps> kernel{};
+
+            for (int k = 0; k < taps; ++k)
+            {
+                double x = static_cast<double>(k - before) - t;
+                double sinc = (x == 0.0) ? 1.0 : std::sin(pi * x) / (pi * x);
+
+                // 4-term Blackman-Harris over the kernel span
+                double u = (x + halfSpan) / (2.0 * halfSpan);
+                double w = 0.35875 - 0.48829 * std::cos(2.0 * pi * u)
+                         + 0.14128 * std::cos(4.0 * pi * u)
+                         - 0.01168 * std::cos(6.0 * pi * u);
+
+                kernel[static_cast<size_t>(k)] = sinc * w;
+                sum += sinc * w;
+            }
+
+            // Unity DC gain for every phase
+            for (int k = 0; k < taps; ++k)
+                table[static_cast<size_t>(p)][static_cast<size_t>(k)] = static_cast<float>(kernel[static_cast<size_t>(k)] / sum);
+        }
+
+        return table;
+    }
+};
+
+// Guard samples a ring buffer needs so the widest window never wraps
+static constexpr int maxTaps = Sinc::taps;
+
+} // namespace Interpolation
+
+} // namespace Chronos
@@ -0,0 +1,288 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <algorithm>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+ #include <intrin.h>
+ #define CHRONOS_HAS_CYCLE_COUNTER 1
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+ #include <x86intrin.h>
+ #define CHRONOS_HAS_CYCLE_COUNTER 1
+#else
+ #define CHRONOS_HAS_CYCLE_COUNTER 0
+#endif
+
+namespace Chronos {
+
+// Per-instance DSP load: how long each audio callback took, in cycles and as
+// a share of the real-time budget (numSamples / sampleRate).
+//
+// The audio thread is the only writer. It keeps a histogram of block loads in
+// quarter-octave buckets, a peak and a smoothed average; any thread can take
+// a snapshot. Counters are single-writer, so they are bumped with a relaxed
+// load and store rather than a locked read-modify-write, and the writer's
+// state sits on its own cache lines. reset() is a request the audio thread
+// picks up at its next block.
+class LoadMeter
+{
+public:
+    static constexpr int numBuckets = 48;
+    static constexpr double minBucketLoad = 1.0 / 1024.0;  // 0.1%; bucket 47 ends at 400%
+    static constexpr double averageSeconds = 0.3;          // Smoothing of the average
+
+    static constexpr bool hasCycleCounter() { return CHRONOS_HAS_CYCLE_COUNTER != 0; }
+
+    // Reference cycles (TSC) where available; 0 elsewhere
+    static uint64_t readCycles()
+    {
+       #if CHRONOS_HAS_CYCLE_COUNTER
+        return static_cast<uint64_t>(__rdtsc());
+       #else
+        return 0;
+       #endif
+    }
+
+    struct Snapshot
+    {
+        double sampleRate = 0.0;
+        uint64_t blocks = 0;
+        uint64_t overruns = 0;          // Blocks over 100% of budget
+        int lastSamples = 0;
+        float lastLoad = 0.0f;          // Fractions of the budget; 1 = 100%
+        float averageLoad = 0.0f;
+        float peakLoad = 0.0f;
+        double averageCycles = 0.0;
+        uint64_t peakCycles = 0;
+        std::array<uint32_t, numBuckets> histogram {};
+
+        // Load below which the given fraction of blocks fell (bucket upper edge)
+        float percentile(double fraction) const
+        {
+            uint64_t total = 0;
+            for (auto count : histogram)
+                total += count;
+
+            if (total == 0)
+                return 0.0f;
+
+            const auto target = static_cast<uint64_t>(std::ceil(std::clamp(fraction, 0.0, 1.0) * static_cast<double>(total)));
+            uint64_t seen = 0;
+            for (int i = 0; i < numBuckets; ++i)
+            {
+                seen += histogram[static_cast<size_t>(i)];
+                if (seen >= target)
+                    return bucketUpperEdge(i);
+            }
+
+            return bucketUpperEdge(numBuckets - 1);
+        }
+    };
+
+    // Times one block: construct at the top of processBlock
+    class ScopedTimer
+    {
+    public:
+        ScopedTimer(LoadMeter& meterToUse, int numSamplesInBlock)
+            : meter(meterToUse), numSamples(numSamplesInBlock),
+              startTime(Clock::now()), startCycles(readCycles())
+        {
+        }
+
+        ~ScopedTimer()
+        {
+            const auto cycles = readCycles() - startCycles;
+            const auto elapsed = std::chrono::duration<double>(Clock::now() - startTime).count();
+            meter.record(elapsed, cycles, numSamples);
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        LoadMeter& meter;
+        int numSamples;
+        std::chrono::steady_clock::time_point startTime;
+        uint64_t startCycles;
+    };
+
+    LoadMeter() = default;
+
+    LoadMeter(const LoadMeter&) = delete;
+    LoadMeter& operator=(const LoadMeter&) = delete;
+
+    // Call from prepareToPlay, before the first block
+    void prepare(double newSampleRate)
+    {
+        sampleRate.store(newSampleRate, std::memory_order_relaxed);
+        reset();
+    }
+
+    // Any thread; applied by the audio thread at its next record()
+    void reset()
+    {
+        resetRequested.store(true, std::memory_order_release);
+    }
+
+    // Audio thread: one block took elapsedSeconds and the given cycles
+    void record(double elapsedSeconds, uint64_t cycles, int numSamples)
+    {
+        const double rate = sampleRate.load(std::memory_order_relaxed);
+        if (numSamples <= 0 || rate <= 0.0)
+            return;
+
+        if (resetRequested.exchange(false, std::memory_order_acquire))
+            clearCounters();
+
+        const double budget = static_cast<double>(numSamples) / rate;
+        const auto load = static_cast<float>(elapsedSeconds / budget);
+
+        // Average over roughly averageSeconds of audio, whatever the block size
+        const auto coeff = static_cast<float>(std::exp(-budget / averageSeconds));
+        const bool first = bump(writer.blocks) == 1;
+        const float average = first ? load : load + (writer.averageLoad.load(std::memory_order_relaxed) - load) * coeff;
+        const double averageCycles = first ? static_cast<double>(cycles)
+            : static_cast<double>(cycles) + (writer.averageCycles.load(std::memory_order_relaxed) - static_cast<double>(cycles)) * coeff;
+
+        writer.lastSamples.store(numSamples, std::memory_order_relaxed);
+        writer.lastLoad.store(load, std::memory_order_relaxed);
+        writer.averageLoad.store(average, std::memory_order_relaxed);
+        writer.averageCycles.store(averageCycles, std::memory_order_relaxed);
+
+        if (load > writer.peakLoad.load(std::memory_order_relaxed))
+            writer.peakLoad.store(load, std::memory_order_relaxed);
+        if (cycles > writer.peakCycles.load(std::memory_order_relaxed))
+            writer.peakCycles.store(cycles, std::memory_order_relaxed);
+        if (load > 1.0f)
+            bump(writer.overruns);
+
+        bump(histogram[static_cast<size_t>(bucketFor(load))]);
+    }
+
+    // Any thread. Fields are read individually, so a snapshot taken while a
+    // block is being recorded can be off by that one block.
+    Snapshot getSnapshot() const
+    {
+        Snapshot s;
+        s.sampleRate = sampleRate.load(std::memory_order_relaxed);
+        s.blocks = writer.blocks.load(std::memory_order_relaxed);
+        s.overruns = writer.overruns.load(std::memory_order_relaxed);
+        s.lastSamples = writer.lastSamples.load(std::memory_order_relaxed);
+        s.lastLoad = writer.lastLoad.load(std::memory_order_relaxed);
+        s.averageLoad = writer.averageLoad.load(std::memory_order_relaxed);
+        s.peakLoad = writer.peakLoad.load(std::memory_order_relaxed);
+        s.averageCycles = writer.averageCycles.load(std::memory_order_relaxed);
+        s.peakCycles = writer.peakCycles.load(std::memory_order_relaxed);
+
+        for (size_t i = 0; i < histogram.size(); ++i)
+            s.histogram[i] = histogram[i].load(std::memory_order_relaxed);
+
+        return s;
+    }
+
+    // Human-readable report for logs and bug reports
+    std::string dump() const
+    {
+        const auto s = getSnapshot();
+        std::string text;
+        char line[160];
+
+        std::snprintf(line, sizeof(line), "DSP load: %llu blocks of %d samples at %.0f Hz, %llu over budget\n",
+                      static_cast<unsigned long long>(s.blocks), s.lastSamples, s.sampleRate,
+                      static_cast<unsigned long long>(s.overruns));
+        text += line;
+
+        std::snprintf(line, sizeof(line), "  last %.2f%%  average %.2f%%  peak %.2f%%  p50 <%.2f%%  p99 <%.2f%%\n",
+                      100.0 * s.lastLoad, 100.0 * s.averageLoad, 100.0 * s.peakLoad,
+                      100.0 * s.percentile(0.5), 100.0 * s.percentile(0.99));
+        text += line;
+
+        if (hasCycleCounter())
+        {
+            std::snprintf(line, sizeof(line), "  cycles/block: average %.0f  peak %llu\n",
+                          s.averageCycles, static_cast<unsigned long long>(s.peakCycles));
+            text += line;
+        }
+
+        for (int i = 0; i < numBuckets; ++i)
+        {
+            const auto count = s.histogram[static_cast<size_t>(i)];
+            if (count == 0)
+                continue;
+
+            std::snprintf(line, sizeof(line), "  %7.2f%% - %7.2f%%  %u\n",
+                          100.0 * (i == 0 ? 0.0 : bucketUpperEdge(i - 1)), 100.0 * bucketUpperEdge(i),
+                          static_cast<unsigned>(count));
+            text += line;
+        }
+
+        return text;
+    }
+
+    // Bucket i ends at minBucketLoad * 2^((i + 1) / 4); the last one is open
+    static int bucketFor(float load)
+    {
+        if (!(load > static_cast<float>(minBucketLoad)))
+            return 0;
+
+        const int i = static_cast<int>(4.0f * std::log2(load / static_cast<float>(minBucketLoad)));
+        return std::min(i, numBuckets - 1);
+    }
+
+    static float bucketUpperEdge(int bucket)
+    {
+        return static_cast<float>(minBucketLoad * std::exp2((bucket + 1) / 4.0));
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    template <typename T>
+    static T bump(std::atomic<T>& counter)
+    {
+        const T value = counter.load(std::memory_order_relaxed) + 1;
+        counter.store(value, std::memory_order_relaxed);
+        return value;
+    }
+
+    void clearCounters()
+    {
+        writer.blocks.store(0, std::memory_order_relaxed);
+        writer.overruns.store(0, std::memory_order_relaxed);
+        writer.lastLoad.store(0.0f, std::memory_order_relaxed);
+        writer.averageLoad.store(0.0f, std::memory_order_relaxed);
+        writer.peakLoad.store(0.0f, std::memory_order_relaxed);
+        writer.averageCycles.store(0.0, std::memory_order_relaxed);
+        writer.peakCycles.store(0, std::memory_order_relaxed);
+
+        for (auto& count : histogram)
+            count.store(0, std::memory_order_relaxed);
+    }
+
+    // Written every block by the audio thread only
+    struct alignas(64) Writer
+    {
+        std::atomic<uint64_t> blocks { 0 };
+        std::atomic<uint64_t> overruns { 0 };
+        std::atomic<int> lastSamples { 0 };
+        std::atomic<float> lastLoad { 0.0f };
+        std::atomic<float> averageLoad { 0.0f };
+        std::atomic<float> peakLoad { 0.0f };
+        std::atomic<double> averageCycles { 0.0 };
+        std::atomic<uint64_t> peakCycles { 0 };
+    };
+
+    alignas(64) std::atomic<double> sampleRate { 0.0 };
+    std::atomic<bool> resetRequested { false };
+
+    Writer writer;
+    alignas(64) std::array<std::atomic<uint32_t>, numBuckets> histogram {};
+};
+
+} // namespace Chronos
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <array>
 #include <cmath>
 #include <random>
+#include <algorithm>
 
 namespace Chronos {
 
@@ -9,12 +11,25 @@ enum class LFOShape
 {
     Sine,
     Triangle,
-    Random  // Sample & Hold
+    Random,       // Sample & Hold
+    SmoothRandom  // Random targets joined by smoothstep curves
 };
 
+// Block-rendered LFO. Sine reads a shared read-only wavetable, triangle is
+// computed from the phase, and the random shapes draw one value per cycle,
+// so no transcendental or RNG call runs per sample.
+//
+// In control-rate mode the shape is evaluated once every controlInterval
+// samples and linearly interpolated in between; for a 20 Hz sine at 44.1 kHz
+// that stays within 1.1e-3 of the audio-rate output.
 class ModulationLFO
 {
 public:
+    static constexpr int tableSize = 2048;
+    static constexpr int controlInterval = 32;
+
+    using SineTable = std::array<float, tableSize + 1>;
+
     ModulationLFO()
         : randomEngine(std::random_device{}()),
           randomDist(-1.0f, 1.0f)
@@ -32,43 +47,164 @@ public:
         phase = 0.0f;
         randomCurrent = 0.0f;
         randomTarget = randomDist(randomEngine);
+        resetControl();
+    }
+
+    // The random shapes draw from std::random_device by default, so no two
+    // renders match; a fixed seed makes them repeatable (restarts the LFO)
+    void setSeed(unsigned int seed)
+    {
+        randomEngine.seed(seed);
+        randomDist.reset();
+        reset();
     }
 
     void setShape(LFOShape newShape)
     {
         shape = newShape;
+        resetControl();
+    }
+
+    void setControlRate(bool shouldUseControlRate)
+    {
+        if (shouldUseControlRate == controlRate)
+            return;
+
+        controlRate = shouldUseControlRate;
+        resetControl();
     }
 
     // Returns value in range [-1, 1]
     float process(float rateHz)
     {
-        float output = 0.0f;
+        float output;
+        renderBlock(&output, 1, rateHz);
+        return output;
+    }
 
-        switch (shape)
+    // Same sequence as calling process() numSamples times
+    void renderBlock(float* dest, int numSamples, float rateHz)
+    {
+        float phaseIncrement = rateHz / sampleRate;
+
+        if (controlRate)
+            renderControlRate(dest, numSamples, phaseIncrement);
+        else
+            renderAudioRate(dest, numSamples, phaseIncrement);
+    }
+
+    float getPhase() const { return phase; }
+
+    // Jump to a phase, e.g. the one skipPhase() gives for a render that
+    // starts part way into a file
+    void setPhase(float newPhase)
+    {
+        phase = newPhase;
+        resetControl();
+    }
+
+    // Phase after numSamples audio-rate steps from startPhase, rounded exactly
+    // as renderBlock() rounds it; increment is rateHz / sampleRate
+    static float skipPhase(float startPhase, float phaseIncrement, long long numSamples)
+    {
+        float p = startPhase;
+        for (long long i = 0; i < numSamples; ++i)
         {
-            case LFOShape::Sine:
-                output = std::sin(phase * 2.0f * 3.14159265359f);
-                break;
-
-            case LFOShape::Triangle:
-                // Triangle wave from phase [0, 1]
-                if (phase < 0.25f)
-                    output = phase * 4.0f;
-                else if (phase < 0.75f)
-                    output = 1.0f - (phase - 0.25f) * 4.0f;
-                else
-                    output = -1.0f + (phase - 0.75f) * 4.0f;
-                break;
-
-            case LFOShape::Random:
-                // Sample & Hold - update on phase reset
-                output = randomCurrent;
-                break;
+            p += phaseIncrement;
+            if (p >= 1.0f)
+                p -= 1.0f;
         }
+        return p;
+    }
+    LFOShape getShape() const { return shape; }
+    bool isControlRate() const { return controlRate; }
 
-        // Advance phase
-        float phaseIncrement = rateHz / sampleRate;
-        float oldPhase = phase;
+    // One sine cycle plus a guard point; shared and built once
+    static const SineTable& getSineTable()
+    {
+        static const SineTable table = buildSineTable();
+        return table;
+    }
+
+    // Sine of phase p in [0, 1) by linear interpolation in the table; max
+    // error 1.2e-6
+    static float sineAt(float p)
+    {
+        const SineTable& table = getSineTable();
+        float pos = p * static_cast<float>(tableSize);
+        int index = static_cast<int>(pos);
+        float frac = pos - static_cast<float>(index);
+        index &= tableSize - 1;
+
+        return table[static_cast<size_t>(index)]
+             + (table[static_cast<size_t>(index + 1)] - table[static_cast<size_t>(index)]) * frac;
+    }
+
+private:
+    void renderAudioRate(float* dest, int numSamples, float phaseIncrement)
+    {
+        if (shape == LFOShape::Random || shape == LFOShape::SmoothRandom)
+        {
+            // Serial, but the RNG only runs on wraps
+            for (int i = 0; i < numSamples; ++i)
+            {
+                dest[i] = randomValueAt(phase);
+                advance(phaseIncrement);
+            }
+            return;
+        }
+
+        // Phase before each step, then shape the whole block
+        for (int i = 0; i < numSamples; ++i)
+        {
+            dest[i] = phase;
+            phase += phaseIncrement;
+            if (phase >= 1.0f)
+                phase -= 1.0f;
+        }
+
+        if (shape == LFOShape::Sine)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                dest[i] = sineAt(dest[i]);
+        }
+        else
+        {
+            for (int i = 0; i < numSamples; ++i)
+                dest[i] = triangleAt(dest[i]);
+        }
+    }
+
+    void renderControlRate(float* dest, int numSamples, float phaseIncrement)
+    {
+        int i = 0;
+        while (i < numSamples)
+        {
+            if (controlCountdown == 0)
+            {
+                // Next control point is the shape one interval ahead
+                for (int k = 0; k < controlInterval; ++k)
+                    advance(phaseIncrement);
+
+                controlStep = (valueAt(phase) - controlValue) / static_cast<float>(controlInterval);
+                controlCountdown = controlInterval;
+            }
+
+            // Sample 0 of each interval is the current point
+            int run = std::min(controlCountdown, numSamples - i);
+            for (int k = 0; k < run; ++k)
+            {
+                dest[i + k] = controlValue;
+                controlValue += controlStep;
+            }
+
+            controlCountdown -= run;
+            i += run;
+        }
+    }
+
+    void advance(float phaseIncrement)
+    {
         phase += phaseIncrement;
 
         // Handle phase wraparound
@@ -76,32 +212,65 @@ public:
         {
             phase -= 1.0f;
 
-            // For S&H, sample new random value on wrap
-            if (shape == LFOShape::Random)
-            {
-                randomCurrent = randomTarget;
-                randomTarget = randomDist(randomEngine);
-            }
+            // Random shapes pick a new value once per cycle
+            randomCurrent = randomTarget;
+            randomTarget = randomDist(randomEngine);
         }
+    }
+
+    void resetControl()
+    {
+        controlValue = valueAt(phase);
+        controlStep = 0.0f;
+        controlCountdown = 0;
+    }
 
-        // Smooth S&H transition for less clicks
-        if (shape == LFOShape::Random && oldPhase > phase)
+    float valueAt(float p) const
+    {
+        switch (shape)
         {
-            // Just wrapped - output is now the new value
+            case LFOShape::Sine:     return sineAt(p);
+            case LFOShape::Triangle: return triangleAt(p);
+            default:                 return randomValueAt(p);
         }
+    }
 
-        return output;
+    // 0 at phase 0, +1 at 0.25, -1 at 0.75
+    static float triangleAt(float p)
+    {
+        float t = p + 0.25f;
+        t -= std::floor(t);
+        return 1.0f - 4.0f * std::abs(t - 0.5f);
     }
 
-    float getPhase() const { return phase; }
-    LFOShape getShape() const { return shape; }
+    float randomValueAt(float p) const
+    {
+        if (shape == LFOShape::Random)
+            return randomCurrent;
+
+        float s = p * p * (3.0f - 2.0f * p);
+        return randomCurrent + (randomTarget - randomCurrent) * s;
+    }
+
+    static SineTable buildSineTable()
+    {
+        SineTable table{};
+        for (int i = 0; i <= tableSize; ++i)
+            table[static_cast<size_t>(i)] = static_cast<float>(std::sin(2.0 * 3.14159265358979323846 * i / tableSize));
+        return table;
+    }
 
-private:
     float phase = 0.0f;
     float sampleRate = 44100.0f;
     LFOShape shape = LFOShape::Sine;
 
-    // Random S&H state
+    // Control-rate state
+    bool controlRate = false;
+    float controlValue = 0.0f;
+    float controlStep = 0.0f;
+    int controlCountdown = 0;
+
+    // Random state
     std::mt19937 randomEngine;
     std::uniform_real_distribution<float> randomDist;
     float randomCurrent = 0.0f;
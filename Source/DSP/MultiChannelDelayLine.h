@@ -0,0 +1,438 @@
+#pragma once
+
+#include "DelayPages.h"
+#include "SampleFormat.h"
+#include <array>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+namespace Chronos {
+
+// Multichannel ring buffer: the channels of a frame are stored interleaved and
+// share one write index, so a write or tap touches a single memory stream and
+// does the wrap arithmetic once for every channel. Channels that share a delay
+// time share one interpolation window, and their lanes are interpolated
+// together (adjacent floats, one vector op per term). Like DelayLine, the
+// capacity is a power of two so indices wrap with a mask.
+//
+// Storage is paged (see DelayPages): only the history the current delay needs
+// is committed, so a long maximum delay costs nothing until it is used. The
+// owner reports the delay in use with setRequiredDelay() and calls
+// servicePages() from a non-realtime thread.
+//
+// Frames can be stored as 16-bit (see DelayStorage). Packed windows are
+// unpacked before interpolating; readBlock() unpacks the span a sub-block
+// reads in one pass per channel rather than per tap.
+class MultiChannelDelayLine
+{
+public:
+    static constexpr int guardFrames = DelayLine::guardSamples;
+    static constexpr int pageFrames = DelayPages<float>::pageFrames;
+    static constexpr int maxChannels = DelayPages<float>::maxChannels;
+
+    MultiChannelDelayLine() = default;
+
+    void prepare(float sampleRate, float maxDelayMs, int numChannels, BufferArena& arena,
+                 DelayStorage storage = DelayStorage::Float32)
+    {
+        this->sampleRate = sampleRate;
+        this->maxDelayMs = maxDelayMs;
+        channels = std::clamp(numChannels, 1, maxChannels);
+
+        // Calculate buffer size with some headroom
+        int maxFrames = static_cast<int>(std::ceil(maxDelayMs * sampleRate / 1000.0f)) + 4;
+
+        // Only the selected format's pages are allocated
+        format = storage;
+        if (format == DelayStorage::Float32)
+        {
+            capacity = floatPages.prepare(maxFrames, channels);
+            packedPages.release();
+            unpacked = nullptr;
+        }
+        else
+        {
+            capacity = packedPages.prepare(maxFrames, channels);
+            floatPages.release();
+            unpacked = arena.allocate<float>(static_cast<size_t>(unpackChunkFrames));
+        }
+
+        mask = capacity - 1;
+        writeIndex = 0;
+        frozen = false;
+    }
+
+    int getNumChannels() const { return channels; }
+
+    // Silences the buffer; the write position (and so the committed pages)
+    // is kept
+    void clear()
+    {
+        floatPages.clear();
+        packedPages.clear();
+        frozen = false;
+    }
+
+    // One frame: a sample per channel
+    void write(const float* frame)
+    {
+        if (format == DelayStorage::Float32)
+        {
+            float* dest = floatPages.beginWrite(writeIndex);
+            std::copy(frame, frame + channels, dest);
+            floatPages.endWrite(writeIndex, 1);
+        }
+        else
+        {
+            uint16_t* dest = packedPages.beginWrite(writeIndex);
+            for (int ch = 0; ch < channels; ++ch)
+                dest[ch] = pack(frame[ch], dither[static_cast<size_t>(ch)]);
+            packedPages.endWrite(writeIndex, 1);
+        }
+
+        writeIndex = (writeIndex + 1) & mask;
+    }
+
+    // numSamples frames from one array per channel
+    void writeBlock(const float* const* input, int numSamples)
+    {
+        // Contiguous runs up to the end of each page
+        int i = 0;
+        while (i < numSamples)
+        {
+            int run = std::min(numSamples - i, pageFrames - (writeIndex & (pageFrames - 1)));
+
+            if (format == DelayStorage::Float32)
+            {
+                float* frames = floatPages.beginWrite(writeIndex);
+                for (int ch = 0; ch < channels; ++ch)
+                {
+                    const float* src = input[ch] + i;
+                    for (int k = 0; k < run; ++k)
+                        frames[k * channels + ch] = src[k];
+                }
+                floatPages.endWrite(writeIndex, run);
+            }
+            else
+            {
+                uint16_t* frames = packedPages.beginWrite(writeIndex);
+                for (int ch = 0; ch < channels; ++ch)
+                    packRun(input[ch] + i, frames + ch, run, dither[static_cast<size_t>(ch)]);
+                packedPages.endWrite(writeIndex, run);
+            }
+
+            writeIndex = (writeIndex + run) & mask;
+            i += run;
+        }
+    }
+
+    // History the reads need, in frames (longest delay including modulation).
+    // Called from the audio thread; pages follow as the writer advances.
+    void setRequiredDelay(float delayInSamples)
+    {
+        int frames = static_cast<int>(std::ceil(delayInSamples)) + guardFrames;
+        if (format == DelayStorage::Float32)
+            floatPages.setRequiredFrames(frames);
+        else
+            packedPages.setRequiredFrames(frames);
+    }
+
+    // Commits and frees pages off the audio thread (see DelayPages::service())
+    void servicePages()
+    {
+        floatPages.service();
+        packedPages.service();
+    }
+
+    // Cubic interpolation of every channel; delays holds one delay per channel
+    void read(const float* delays, float* frame, int writeAhead = 0) const
+    {
+        Interpolation::Hermite::State states[maxChannels];
+        read<Interpolation::Hermite>(delays, frame, writeAhead, states);
+    }
+
+    // Read with any interpolation policy from Interpolation.h; states points
+    // at one State per channel.
+    template <typename Interp>
+    void read(const float* delays, float* frame, int writeAhead, typename Interp::State* states) const
+    {
+        int writePos = (writeIndex + writeAhead) & mask;
+
+        if (format != DelayStorage::Float32)
+        {
+            for (int ch = 0; ch < channels; ++ch)
+            {
+                float frac;
+                float window[Interp::taps];
+                unpackWindow(windowStart<Interp>(writePos, delays[ch], frac), ch, window, Interp::taps);
+                frame[ch] = Interp::process(window, 1, frac, states[ch]);
+            }
+            return;
+        }
+
+        // Runs of channels with the same delay read one window, lane-wise
+        int ch = 0;
+        while (ch < channels)
+        {
+            float frac;
+            const float* y = window<Interp>(writePos, delays[ch], frac);
+
+            int end = ch + 1;
+            while (end < channels && delays[end] == delays[ch])
+                ++end;
+
+            for (; ch < end; ++ch)
+                frame[ch] = Interp::process(y + ch, channels, frac, states[ch]);
+        }
+    }
+
+    // Freeze: the owner stops writing and reads loop over the last
+    // loopFrames written to each channel. The loop seam is crossfaded with
+    // the frames just before the loop, so the wrap back to its start is
+    // continuous. Loop lengths are clamped to what the buffer holds.
+    void freeze(const int* loopFrames, int crossfadeFrames)
+    {
+        for (int ch = 0; ch < channels; ++ch)
+        {
+            auto& loop = loops[static_cast<size_t>(ch)];
+            int crossfade = std::clamp(crossfadeFrames, 1, capacity / 4);
+            loop.length = std::clamp(loopFrames[ch], 2, capacity - crossfade);
+            loop.crossfade = std::min(crossfade, loop.length / 2);
+            loop.start = (writeIndex - loop.length + capacity) & mask;
+            loop.position = 0;
+        }
+
+        frozen = true;
+    }
+
+    void unfreeze() { frozen = false; }
+    bool isFrozen() const { return frozen; }
+
+    // Next numSamples frames of the frozen loops, one array per channel
+    void readFrozenBlock(float* const* output, int numSamples)
+    {
+        for (int ch = 0; ch < channels; ++ch)
+            readFrozenChannel(ch, output[ch], numSamples);
+    }
+
+    void readFrozen(float* frame)
+    {
+        for (int ch = 0; ch < channels; ++ch)
+            readFrozenChannel(ch, frame + ch, 1);
+    }
+
+    // Reads a sub-block that has not been written yet: sample i reads with
+    // writeAhead = i + 1 (see DelayLine::read). Same results as read().
+    // delays and output hold one array per channel.
+    template <typename Interp>
+    void readBlock(const float* const* delays, float* const* output, int numSamples,
+                   typename Interp::State* states)
+    {
+        if (format == DelayStorage::Float32)
+        {
+            float delayFrame[maxChannels] {};
+            float frame[maxChannels] {};
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                for (int ch = 0; ch < channels; ++ch)
+                    delayFrame[ch] = delays[ch][i];
+
+                read<Interp>(delayFrame, frame, i + 1, states);
+
+                for (int ch = 0; ch < channels; ++ch)
+                    output[ch][i] = frame[ch];
+            }
+            return;
+        }
+
+        for (int ch = 0; ch < channels; ++ch)
+            readPackedChannel<Interp>(ch, delays[ch], output[ch], numSamples, states[ch]);
+    }
+
+    float msToSamples(float ms) const
+    {
+        return ms * sampleRate / 1000.0f;
+    }
+
+    DelayStorage getStorage() const { return format; }
+
+    // Bytes held by the ring buffer's pages
+    size_t getMemoryBytes() const
+    {
+        return floatPages.getMemoryBytes() + packedPages.getMemoryBytes();
+    }
+
+    float getMaxDelayMs() const { return maxDelayMs; }
+    float getSampleRate() const { return sampleRate; }
+
+private:
+    struct FreezeLoop
+    {
+        int start = 0;      // First frame of the loop
+        int length = 2;
+        int crossfade = 1;  // Frames faded into the pre-loop audio at the end
+        int position = 0;   // Next frame to read, relative to start
+    };
+
+    void readFrozenChannel(int ch, float* dest, int numSamples)
+    {
+        auto& loop = loops[static_cast<size_t>(ch)];
+        const int fadeStart = loop.length - loop.crossfade;
+        const float fadeScale = 1.0f / static_cast<float>(loop.crossfade + 1);
+
+        int i = 0;
+        while (i < numSamples)
+        {
+            if (loop.position < fadeStart)
+            {
+                // Plain copy up to the seam region
+                int run = std::min(fadeStart - loop.position, numSamples - i);
+                for (int k = 0; k < run; ++k)
+                {
+                    int index = (loop.start + loop.position + k) & mask;
+                    dest[i + k] = loadSample(index, ch);
+                }
+
+                loop.position += run;
+                i += run;
+            }
+            else
+            {
+                // Seam: fade toward the frames preceding the loop start, which
+                // lead continuously into it
+                int run = std::min(loop.length - loop.position, numSamples - i);
+                for (int k = 0; k < run; ++k)
+                {
+                    int p = loop.position + k;
+                    int index = (loop.start + p) & mask;
+                    int before = (index - loop.length + capacity) & mask;
+                    float fade = static_cast<float>(p - fadeStart + 1) * fadeScale;
+
+                    float a = loadSample(index, ch);
+                    float b = loadSample(before, ch);
+                    dest[i + k] = a + (b - a) * fade;
+                }
+
+                loop.position += run;
+                i += run;
+
+                if (loop.position == loop.length)
+                    loop.position = 0;
+            }
+        }
+    }
+
+    // First frame of the policy's window around writePos - delay (see
+    // DelayLine::window)
+    template <typename Interp>
+    int windowStart(int writePos, float delayInSamples, float& frac) const
+    {
+        int whole = static_cast<int>(delayInSamples);
+        frac = 1.0f - (delayInSamples - static_cast<float>(whole));
+
+        return (writePos - whole - 1 - Interp::before + capacity) & mask;
+    }
+
+    template <typename Interp>
+    const float* window(int writePos, float delayInSamples, float& frac) const
+    {
+        return floatPages.frame(windowStart<Interp>(writePos, delayInSamples, frac));
+    }
+
+    uint16_t pack(float x, SampleFormat::Dither& channelDither)
+    {
+        if (format == DelayStorage::Float16)
+            return SampleFormat::floatToHalf(x);
+
+        return static_cast<uint16_t>(SampleFormat::floatToInt16(x, channelDither.next()));
+    }
+
+    // Packs count samples of one channel into dest, a frame apart
+    void packRun(const float* src, uint16_t* dest, int count, SampleFormat::Dither& channelDither)
+    {
+        if (format == DelayStorage::Float16)
+        {
+            for (int i = 0; i < count; ++i)
+                dest[i * channels] = SampleFormat::floatToHalf(src[i]);
+        }
+        else
+        {
+            for (int i = 0; i < count; ++i)
+                dest[i * channels] = static_cast<uint16_t>(SampleFormat::floatToInt16(src[i], channelDither.next()));
+        }
+    }
+
+    float loadSample(int frame, int ch) const
+    {
+        if (format == DelayStorage::Float32)
+            return floatPages.frame(frame)[ch];
+
+        return SampleFormat::unpack(packedPages.frame(frame)[ch], format);
+    }
+
+    // Unpacks count frames of one channel starting at frame first (masked),
+    // one run per page
+    void unpackWindow(int first, int ch, float* dest, int count) const
+    {
+        int index = first & mask;
+        int done = 0;
+        while (done < count)
+        {
+            int run = std::min(count - done, pageFrames - (index & (pageFrames - 1)));
+            SampleFormat::unpackRun(packedPages.frame(index) + ch, channels, dest + done, run, format);
+            done += run;
+            index = (index + run) & mask;
+        }
+    }
+
+    // Window starts advance about one frame per sample, so one unpacked
+    // chunk serves many consecutive reads
+    template <typename Interp>
+    void readPackedChannel(int ch, const float* delay, float* out, int numSamples,
+                           typename Interp::State& state)
+    {
+        const int chunkFrames = unpackChunkFrames;
+        int base = 0;
+        int loaded = 0;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            float frac;
+            int start = windowStart<Interp>(writeIndex + i + 1, delay[i], frac);
+
+            // Unwrapped offset of this window from the chunk
+            int offset = (start - base) & mask;
+            if (loaded == 0 || offset + Interp::taps > loaded)
+            {
+                base = start;
+                offset = 0;
+                loaded = chunkFrames;
+                unpackWindow(base, ch, unpacked, loaded);
+            }
+
+            out[i] = Interp::process(unpacked + offset, 1, frac, state);
+        }
+    }
+
+    static constexpr int unpackChunkFrames = 256 + Interpolation::maxTaps;
+
+    DelayPages<float> floatPages;      // Interleaved frames (Float32)
+    DelayPages<uint16_t> packedPages;  // Interleaved frames (16-bit formats)
+    float* unpacked = nullptr;         // One channel's chunk for readBlock()
+    DelayStorage format = DelayStorage::Float32;
+    std::array<SampleFormat::Dither, maxChannels> dither;
+    int channels = 2;
+    int capacity = 0;
+    int mask = 0;
+    int writeIndex = 0;
+
+    std::array<FreezeLoop, maxChannels> loops;
+    bool frozen = false;
+
+    float sampleRate = 44100.0f;
+    float maxDelayMs = 2000.0f;
+};
+
+} // namespace Chronos
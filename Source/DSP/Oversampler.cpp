@@ -0,0 +1,4 @@
+#include "Oversampler.h"
+
+// Implementation is header-only for inline performance
+// This file exists for build system compatibility
@@ -0,0 +1,365 @@
+#pragma once
+
+#include "BufferArena.h"
+#include <array>
+#include <cmath>
+#include <algorithm>
+
+namespace Chronos {
+
+// Half-band designs for the polyphase IIR resamplers below: elliptic
+// half-band filters realised as two parallel chains of first-order allpass
+// sections in z^-2 (hiir-style). Coefficients were designed offline with
+// the Valenzuela/Constantinides method; even indices feed one polyphase
+// branch, odd indices the other.
+namespace HalfBand {
+
+// base <-> 2x: passband to 0.46 fs (base rate), >= 99 dB stopband
+struct Steep
+{
+    static constexpr int numCoeffs = 8;
+    static constexpr std::array<float, numCoeffs> coeffs = {
+        0.040633461f, 0.150505129f, 0.300757056f, 0.460774505f,
+        0.609524315f, 0.738503841f, 0.849223810f, 0.949742784f
+    };
+};
+
+// 2x <-> 4x: only has to keep the steep stage's passband (0.23 fs at this
+// rate), so a wide transition band gives >= 80 dB with half the sections
+struct Wide
+{
+    static constexpr int numCoeffs = 4;
+    static constexpr std::array<float, numCoeffs> coeffs = {
+        0.065297260f, 0.241802998f, 0.492545474f, 0.805922672f
+    };
+};
+
+// Group delay at DC of one branch's allpass chain, (1 - a) / (1 + a) per
+// section, in samples at the lower of the filter's two rates
+template <typename Design>
+constexpr float branchDelay(int branch)
+{
+    float delay = 0.0f;
+    for (int i = branch; i < Design::numCoeffs; i += 2)
+        delay += (1.0f - Design::coeffs[static_cast<size_t>(i)]) / (1.0f + Design::coeffs[static_cast<size_t>(i)]);
+    return delay;
+}
+
+// Up then down through the same design: the half-sample offsets between the
+// branches cancel, leaving the sum of both chains
+template <typename Design>
+constexpr float roundTripDelay()
+{
+    return branchDelay<Design>(0) + branchDelay<Design>(1);
+}
+
+// One pass through both branches' allpass chains. The two branches sit in
+// adjacent state slots, so each step is a 2-lane vector operation.
+template <typename Design>
+inline void processBranches(float& branch0, float& branch1, float* x, float* y)
+{
+    static_assert(Design::numCoeffs % 2 == 0, "branches need the same number of sections");
+
+    for (int i = 0; i < Design::numCoeffs; i += 2)
+    {
+        float out0 = (branch0 - y[i]) * Design::coeffs[static_cast<size_t>(i)] + x[i];
+        float out1 = (branch1 - y[i + 1]) * Design::coeffs[static_cast<size_t>(i + 1)] + x[i + 1];
+
+        x[i] = branch0;
+        x[i + 1] = branch1;
+        y[i] = out0;
+        y[i + 1] = out1;
+
+        branch0 = out0;
+        branch1 = out1;
+    }
+}
+
+template <typename Design>
+class Upsampler
+{
+public:
+    void reset()
+    {
+        x.fill(0.0f);
+        y.fill(0.0f);
+    }
+
+    // numSamples in, 2 * numSamples out
+    void processBlock(const float* input, float* output, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            float even = input[i];
+            float odd = input[i];
+            processBranches<Design>(even, odd, x.data(), y.data());
+            output[2 * i] = even;
+            output[2 * i + 1] = odd;
+        }
+    }
+
+private:
+    std::array<float, Design::numCoeffs> x {};
+    std::array<float, Design::numCoeffs> y {};
+};
+
+template <typename Design>
+class Downsampler
+{
+public:
+    void reset()
+    {
+        x.fill(0.0f);
+        y.fill(0.0f);
+    }
+
+    // 2 * numSamples in, numSamples out; safe in place
+    void processBlock(const float* input, float* output, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            float branch0 = input[2 * i + 1];
+            float branch1 = input[2 * i];
+            processBranches<Design>(branch0, branch1, x.data(), y.data());
+            output[i] = 0.5f * (branch0 + branch1);
+        }
+    }
+
+private:
+    std::array<float, Design::numCoeffs> x {};
+    std::array<float, Design::numCoeffs> y {};
+};
+
+} // namespace HalfBand
+
+// Runs a memoryless nonlinearity at 2x or 4x the base rate, one channel.
+//
+// The owner enables it while the stage is actually nonlinear (drive > 0).
+// While disabled the shaper runs at the base rate with no filtering. On
+// enable the filters are warmed up on recent input and crossfaded in from
+// the base-rate result, and on disable they are crossfaded out, so toggling
+// does not click. All buffers come from the arena passed to prepare().
+//
+// The round trip delays the stage by about 3.07 base-rate samples at 2x and
+// 4.04 at 4x (group delay at DC). While the two paths are crossfaded the
+// base-rate one is delayed to match the share of that latency the output
+// carries, so the owner can take getLatencyAt() off a delay read in a
+// feedback loop and the loop's timing neither drifts nor jumps.
+class Oversampler
+{
+public:
+    static constexpr int maxFactor = 4;
+    static constexpr int historySamples = 64;
+    static constexpr int crossfadeSamples = 64;
+
+    static constexpr float latency2x = HalfBand::roundTripDelay<HalfBand::Steep>();
+    static constexpr float latency4x = latency2x + 0.5f * HalfBand::roundTripDelay<HalfBand::Wide>();
+
+    void prepare(int maxBlockSize, BufferArena& arena)
+    {
+        blockSize = std::max(maxBlockSize, 1);
+        buffer2x = arena.allocate<float>(static_cast<size_t>(blockSize) * 2);
+        buffer4x = arena.allocate<float>(static_cast<size_t>(blockSize) * 4);
+        bypass = arena.allocate<float>(static_cast<size_t>(blockSize));
+        reset();
+    }
+
+    void reset()
+    {
+        stop();
+        history.fill(0.0f);
+    }
+
+    // 1 (off), 2 or 4. A change restarts the filters.
+    void setFactor(int newFactor)
+    {
+        newFactor = newFactor >= 4 ? 4 : (newFactor >= 2 ? 2 : 1);
+        if (newFactor == factor)
+            return;
+
+        factor = newFactor;
+        stop();
+    }
+
+    int getFactor() const { return factor; }
+
+    void setEnabled(bool shouldBeEnabled) { enabled = shouldBeEnabled; }
+
+    // True while the oversampled path contributes to the output
+    bool isRunning() const { return running; }
+
+    // Group delay at DC of the oversampled path at the current factor, in
+    // base-rate samples; 0 at 1x
+    float getLatencySamples() const
+    {
+        return factor == 4 ? latency4x : (factor == 2 ? latency2x : 0.0f);
+    }
+
+    // Latency of sample i of the next process() call: 0 while the base-rate
+    // path runs alone, easing to getLatencySamples() over the fade in (an
+    // S-curve, so a delay read that follows it changes speed smoothly)
+    float getLatencyAt(int i) const
+    {
+        const float mix = getFadeAt(i);
+        return getLatencySamples() * mix * mix * (3.0f - 2.0f * mix);
+    }
+
+    // True while the latency is easing in or out, or will start to on the
+    // next process() call
+    bool isLatencyChanging() const
+    {
+        return getFadeAt(0) != getFadeAt(crossfadeSamples);
+    }
+
+    // shaper(const float* in, float* out, int numSamples, int shift) applies
+    // the nonlinearity; sample i of the block it sees corresponds to base-rate
+    // sample (i >> shift). input may equal output.
+    template <typename Shaper>
+    void process(const float* input, float* output, int numSamples, Shaper&& shaper)
+    {
+        if (!running && (!enabled || factor == 1))
+        {
+            pushHistory(input, numSamples);
+            shaper(input, output, numSamples, 0);
+            return;
+        }
+
+        if (!running)
+            start();
+
+        bool fading = enabled ? fade < 1.0f : true;
+        if (fading)
+        {
+            delayBypass(input, numSamples);
+            shaper(bypass, bypass, numSamples, 0);
+        }
+
+        pushHistory(input, numSamples);
+
+        if (factor == 4)
+        {
+            up2x.processBlock(input, buffer2x, numSamples);
+            up4x.processBlock(buffer2x, buffer4x, numSamples * 2);
+            shaper(buffer4x, buffer4x, numSamples * 4, 2);
+            down4x.processBlock(buffer4x, buffer2x, numSamples * 2);
+            down2x.processBlock(buffer2x, output, numSamples);
+        }
+        else
+        {
+            up2x.processBlock(input, buffer2x, numSamples);
+            shaper(buffer2x, buffer2x, numSamples * 2, 1);
+            down2x.processBlock(buffer2x, output, numSamples);
+        }
+
+        if (fading)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float mix = getFadeAt(i);
+                if (mix < 1.0f)
+                    output[i] = bypass[i] + (output[i] - bypass[i]) * mix;
+            }
+
+            fade = getFadeAt(numSamples - 1);
+            if (!enabled && fade <= 0.0f)
+                stop();
+        }
+    }
+
+private:
+    // Oversampled path's share of the output at sample i of the next block
+    float getFadeAt(int i) const
+    {
+        if (!running && (!enabled || factor == 1))
+            return 0.0f;
+
+        const float step = (enabled ? 1.0f : -1.0f) / static_cast<float>(crossfadeSamples);
+        return std::clamp(fade + step * static_cast<float>(i + 1), 0.0f, 1.0f);
+    }
+
+    // Base-rate input delayed by each sample's latency into bypass (linear
+    // interpolation; the delay is only fractional during a fade)
+    void delayBypass(const float* input, int numSamples)
+    {
+        auto at = [this, input](int i) {
+            return i >= 0 ? input[i] : history[static_cast<size_t>(historySamples + i)];
+        };
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float pos = static_cast<float>(i) - getLatencyAt(i);
+            const float whole = std::floor(pos);
+            const float frac = pos - whole;
+            const int index = static_cast<int>(whole);
+            const float x0 = at(index);
+            bypass[i] = frac > 0.0f ? x0 + (at(index + 1) - x0) * frac : x0;
+        }
+    }
+
+    void start()
+    {
+        // Bring the filters to the state continuous running would have left
+        // them in (linear signal), then fade in from the base-rate path
+        resetFilters();
+
+        for (int offset = 0; offset < historySamples; offset += blockSize)
+        {
+            int len = std::min(historySamples - offset, blockSize);
+            up2x.processBlock(history.data() + offset, buffer2x, len);
+            if (factor == 4)
+            {
+                up4x.processBlock(buffer2x, buffer4x, len * 2);
+                down4x.processBlock(buffer4x, buffer2x, len * 2);
+            }
+            down2x.processBlock(buffer2x, bypass, len);
+        }
+
+        running = true;
+        fade = 0.0f;
+    }
+
+    void stop()
+    {
+        running = false;
+        fade = 0.0f;
+        resetFilters();
+    }
+
+    void resetFilters()
+    {
+        up2x.reset();
+        up4x.reset();
+        down2x.reset();
+        down4x.reset();
+    }
+
+    void pushHistory(const float* input, int numSamples)
+    {
+        if (numSamples >= historySamples)
+        {
+            std::copy(input + numSamples - historySamples, input + numSamples, history.begin());
+            return;
+        }
+
+        std::copy(history.begin() + numSamples, history.end(), history.begin());
+        std::copy(input, input + numSamples, history.end() - numSamples);
+    }
+
+    HalfBand::Upsampler<HalfBand::Steep> up2x;
+    HalfBand::Upsampler<HalfBand::Wide> up4x;
+    HalfBand::Downsampler<HalfBand::Wide> down4x;
+    HalfBand::Downsampler<HalfBand::Steep> down2x;
+
+    float* buffer2x = nullptr;
+    float* buffer4x = nullptr;
+    float* bypass = nullptr;
+    int blockSize = 1;
+    std::array<float, historySamples> history {};
+
+    int factor = 2;
+    bool enabled = false;
+    bool running = false;
+    float fade = 0.0f;
+};
+
+} // namespace Chronos
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "BufferArena.h"
+#include <array>
+#include <cstdint>
+#include <algorithm>
+
+namespace Chronos {
+
+// Linear ramp toward a target over a fixed time
+class LinearSmoother
+{
+public:
+    LinearSmoother() = default;
+
+    void prepare(float sampleRate, float rampMs)
+    {
+        rampSamples = std::max(1, static_cast<int>(sampleRate * rampMs / 1000.0f));
+        snapTo(target);
+    }
+
+    void snapTo(float value)
+    {
+        current = value;
+        target = value;
+        countdown = 0;
+    }
+
+    void setTarget(float newTarget)
+    {
+        if (newTarget == target)
+            return;
+
+        target = newTarget;
+        countdown = rampSamples;
+        step = (target - current) / static_cast<float>(countdown);
+    }
+
+    bool isMoving() const { return countdown > 0; }
+    float getCurrent() const { return current; }
+    float getTarget() const { return target; }
+
+    float getNextValue()
+    {
+        if (countdown <= 0)
+            return current;
+
+        if (--countdown == 0)
+            current = target;
+        else
+            current += step;
+
+        return current;
+    }
+
+    // Same sequence as calling getNextValue() numSamples times
+    void render(float* dest, int numSamples)
+    {
+        int i = 0;
+
+        for (; i < numSamples && countdown > 1; ++i)
+        {
+            current += step;
+            --countdown;
+            dest[i] = current;
+        }
+
+        if (i < numSamples && countdown == 1)
+        {
+            current = target;
+            countdown = 0;
+            dest[i++] = current;
+        }
+
+        for (; i < numSamples; ++i)
+            dest[i] = current;
+    }
+
+private:
+    float current = 0.0f;
+    float target = 0.0f;
+    float step = 0.0f;
+    int countdown = 0;
+    int rampSamples = 1;
+};
+
+// Per-sample smoothing for a fixed set of parameters.
+//
+// renderBlock() writes a ramp array only for parameters that are moving at
+// the start of the block and flags the rest as static, so stages can take a
+// constant-value fast path for the (usual) case of idle parameters.
+template <size_t NumParams>
+class ParameterSmoother
+{
+public:
+    static_assert(NumParams <= 32, "moving flags are a 32-bit mask");
+
+    // View of one parameter over a span of the current block
+    struct Ramp
+    {
+        const float* values = nullptr;  // nullptr when static
+        float constant = 0.0f;
+
+        bool isMoving() const { return values != nullptr; }
+        float operator[](int i) const { return values != nullptr ? values[i] : constant; }
+    };
+
+    // Ramp arrays come from arena and live until it is released
+    void prepare(float sampleRate, int maxBlockSize, const std::array<float, NumParams>& rampTimesMs,
+                 BufferArena& arena)
+    {
+        for (size_t i = 0; i < NumParams; ++i)
+        {
+            smoothers[i].prepare(sampleRate, rampTimesMs[i]);
+            ramps[i] = arena.allocate<float>(static_cast<size_t>(std::max(maxBlockSize, 1)));
+        }
+
+        movingMask = 0;
+    }
+
+    void snapTo(size_t param, float value) { smoothers[param].snapTo(value); }
+    void setTarget(size_t param, float value) { smoothers[param].setTarget(value); }
+
+    bool isMoving(size_t param) const { return smoothers[param].isMoving(); }
+    float getCurrent(size_t param) const { return smoothers[param].getCurrent(); }
+    float getTarget(size_t param) const { return smoothers[param].getTarget(); }
+
+    // Renders numSamples (<= maxBlockSize) of every moving parameter
+    void renderBlock(int numSamples)
+    {
+        movingMask = 0;
+
+        for (size_t i = 0; i < NumParams; ++i)
+        {
+            blockValues[i] = smoothers[i].getCurrent();
+
+            if (smoothers[i].isMoving())
+            {
+                smoothers[i].render(ramps[i], numSamples);
+                movingMask |= (1u << i);
+            }
+        }
+    }
+
+    // Parameter view for the rendered block, starting offset samples in
+    Ramp getRamp(size_t param, int offset) const
+    {
+        if ((movingMask & (1u << param)) != 0)
+            return { ramps[param] + offset, 0.0f };
+
+        return { nullptr, blockValues[param] };
+    }
+
+    bool anyMoving() const { return movingMask != 0; }
+
+    // Per-sample stepping for the scalar reference path
+    std::array<float, NumParams> getNextValues()
+    {
+        std::array<float, NumParams> values;
+        for (size_t i = 0; i < NumParams; ++i)
+            values[i] = smoothers[i].getNextValue();
+        return values;
+    }
+
+private:
+    std::array<LinearSmoother, NumParams> smoothers;
+    std::array<float*, NumParams> ramps {};
+    std::array<float, NumParams> blockValues {};
+    uint32_t movingMask = 0;
+};
+
+} // namespace Chronos
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+namespace Chronos {
+
+// Sample storage for the delay line ring buffer, chosen at prepare time.
+// The 16-bit formats halve the footprint and memory traffic of long delays.
+enum class DelayStorage
+{
+    Float32,
+    Float16,  // IEEE half: 11-bit mantissa, RMS error about 75 dB below the signal
+    Int16     // TPDF-dithered fixed point over +/-2 (the limiter's range), RMS error about -90 dBFS
+};
+
+// Branch-free conversions (selects only), so the block loops vectorize
+namespace SampleFormat {
+
+inline uint32_t floatBits(float x)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return bits;
+}
+
+inline float bitsToFloat(uint32_t bits)
+{
+    float x;
+    std::memcpy(&x, &bits, sizeof(x));
+    return x;
+}
+
+// Round to nearest even; overflow saturates to infinity, tiny values become
+// half subnormals
+inline uint16_t floatToHalf(float x)
+{
+    uint32_t bits = floatBits(x);
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    uint32_t magnitude = bits & 0x7fffffffu;
+
+    // Normal range: rebias the exponent and round the mantissa
+    uint32_t normal = (magnitude + 0xc8000fffu + ((magnitude >> 13) & 1u)) >> 13;
+
+    // Subnormal range: let the FPU align the mantissa
+    uint32_t subnormal = floatBits(bitsToFloat(magnitude) + 0.5f) - 0x3f000000u;
+
+    uint32_t half = magnitude < 0x38800000u ? subnormal : normal;
+    half = magnitude >= 0x47800000u ? 0x7c00u : half;
+
+    return static_cast<uint16_t>(half | sign);
+}
+
+inline float halfToFloat(uint16_t h)
+{
+    uint32_t bits = static_cast<uint32_t>(h);
+    uint32_t sign = (bits & 0x8000u) << 16;
+    uint32_t magnitude = (bits & 0x7fffu) << 13;
+
+    // Subnormals: scale the mantissa as a float
+    float subnormal = bitsToFloat(magnitude + 0x38800000u) - bitsToFloat(0x38800000u);
+    uint32_t normal = magnitude + 0x38000000u;
+    normal = magnitude >= 0x0f800000u ? normal + 0x38000000u : normal;  // Inf/NaN
+
+    uint32_t result = magnitude < 0x00800000u ? floatBits(subnormal) : normal;
+    return bitsToFloat(result | sign);
+}
+
+static constexpr float int16Scale = 16384.0f;  // +/-2.0 full scale
+
+// dither is TPDF noise in LSBs, in (-1, 1)
+inline int16_t floatToInt16(float x, float dither)
+{
+    float scaled = x * int16Scale + dither;
+    scaled = std::clamp(scaled, -32768.0f, 32767.0f);
+    return static_cast<int16_t>(std::lrint(scaled));
+}
+
+inline float int16ToFloat(int16_t s)
+{
+    return static_cast<float>(s) * (1.0f / int16Scale);
+}
+
+// Cheap TPDF source: the difference of two uniform draws from one LCG
+class Dither
+{
+public:
+    float next()
+    {
+        return uniform() - uniform();
+    }
+
+private:
+    float uniform()
+    {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<float>(state >> 8) * (1.0f / 16777216.0f);
+    }
+
+    uint32_t state = 0x12345678u;
+};
+
+inline float unpack(uint16_t value, DelayStorage format)
+{
+    return format == DelayStorage::Float16 ? halfToFloat(value)
+                                           : int16ToFloat(static_cast<int16_t>(value));
+}
+
+// Unpacks count samples from a packed run spaced stride apart
+inline void unpackRun(const uint16_t* src, int stride, float* dest, int count, DelayStorage format)
+{
+    if (format == DelayStorage::Float16)
+    {
+        for (int i = 0; i < count; ++i)
+            dest[i] = halfToFloat(src[i * stride]);
+    }
+    else
+    {
+        for (int i = 0; i < count; ++i)
+            dest[i] = int16ToFloat(static_cast<int16_t>(src[i * stride]));
+    }
+}
+
+} // namespace SampleFormat
+
+} // namespace Chronos
@@ -73,6 +73,54 @@ public:
         }
     }
 
+    // Block version of process() with the mode switch hoisted out of the loop
+    void processBlock(float* left, float* right, int numSamples)
+    {
+        switch (mode)
+        {
+            case StereoMode::Mono:
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    float mono = (left[i] + right[i]) * 0.5f;
+                    left[i] = mono;
+                    right[i] = mono;
+                }
+                break;
+
+            case StereoMode::Stereo:
+            case StereoMode::PingPong:
+                break;
+
+            case StereoMode::Wide:
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    float mid = (left[i] + right[i]) * 0.5f;
+                    float side = (left[i] - right[i]) * 0.5f * width;
+                    left[i] = mid + side;
+                    right[i] = mid - side;
+                }
+                break;
+        }
+    }
+
+    // As above, with a per-sample width ramp (only Wide mode uses width)
+    void processBlock(float* left, float* right, int numSamples, const float* widthRamp)
+    {
+        if (mode != StereoMode::Wide)
+        {
+            processBlock(left, right, numSamples);
+            return;
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            float mid = (left[i] + right[i]) * 0.5f;
+            float side = (left[i] - right[i]) * 0.5f * std::clamp(widthRamp[i], 0.0f, 2.0f);
+            left[i] = mid + side;
+            right[i] = mid - side;
+        }
+    }
+
     // For ping-pong mode: swap feedback signals
     void processPingPongFeedback(float& leftFeedback, float& rightFeedback)
     {
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+namespace Chronos {
+
+// Summary of one processed block, for meters and displays
+struct alignas(64) BlockTelemetry
+{
+    float inputPeak = 0.0f;     // After input gain, over all channels
+    float inputRms = 0.0f;
+    float wetPeak = 0.0f;       // After ducking and width, before the mix
+    float wetRms = 0.0f;
+    float feedbackPeak = 0.0f;  // Feedback chain output; 0 while frozen
+    float feedbackRms = 0.0f;
+    float lfoPhase = 0.0f;      // At the end of the block, 0-1
+    float duckGain = 1.0f;      // Deepest wet gain in the block; 1 = no ducking
+    int numSamples = 0;
+    bool frozen = false;
+
+    // Folds a later block in: peaks and deepest duck held, RMS power-weighted
+    // by length, phase and freeze state from the latest
+    void merge(const BlockTelemetry& next)
+    {
+        const float total = static_cast<float>(numSamples + next.numSamples);
+        const float a = total > 0.0f ? static_cast<float>(numSamples) / total : 0.0f;
+        const float b = 1.0f - a;
+
+        auto rms = [a, b](float x, float y) { return std::sqrt(a * x * x + b * y * y); };
+
+        inputPeak = std::max(inputPeak, next.inputPeak);
+        inputRms = rms(inputRms, next.inputRms);
+        wetPeak = std::max(wetPeak, next.wetPeak);
+        wetRms = rms(wetRms, next.wetRms);
+        feedbackPeak = std::max(feedbackPeak, next.feedbackPeak);
+        feedbackRms = rms(feedbackRms, next.feedbackRms);
+        lfoPhase = next.lfoPhase;
+        duckGain = std::min(duckGain, next.duckGain);
+        numSamples += next.numSamples;
+        frozen = next.frozen;
+    }
+};
+
+// Peak and mean square of a signal over a block, across channels
+struct SignalStats
+{
+    float peak = 0.0f;
+    double sumSquares = 0.0;
+    int64_t count = 0;
+
+    void clear() { *this = {}; }
+
+    void add(const float* x, int numSamples)
+    {
+        float blockPeak = 0.0f;
+        float blockSum = 0.0f;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            blockPeak = std::max(blockPeak, std::abs(x[i]));
+            blockSum += x[i] * x[i];
+        }
+
+        peak = std::max(peak, blockPeak);
+        sumSquares += blockSum;
+        count += numSamples;
+    }
+
+    float rms() const
+    {
+        return count > 0 ? static_cast<float>(std::sqrt(sumSquares / static_cast<double>(count))) : 0.0f;
+    }
+};
+
+// Single-producer/single-consumer queue of BlockTelemetry from the audio
+// thread to the editor. Each slot is its own cache line, and the producer's
+// and consumer's indices sit on separate lines. The producer keeps a cached
+// copy of the read index, so a push only touches the consumer's line when
+// the cached view says the queue is full. When nobody drains it (no editor
+// open) pushes are dropped and counted; they never block.
+class TelemetryFifo
+{
+public:
+    static constexpr uint32_t capacity = 256;  // ~170 ms of 32-sample blocks at 48 kHz
+
+    TelemetryFifo() = default;
+
+    TelemetryFifo(const TelemetryFifo&) = delete;
+    TelemetryFifo& operator=(const TelemetryFifo&) = delete;
+
+    // Producer
+    bool push(const BlockTelemetry& block)
+    {
+        const uint32_t write = producer.write.load(std::memory_order_relaxed);
+
+        if (write - producer.cachedRead == capacity)
+        {
+            producer.cachedRead = consumer.read.load(std::memory_order_acquire);
+            if (write - producer.cachedRead == capacity)
+            {
+                producer.dropped.store(producer.dropped.load(std::memory_order_relaxed) + 1,
+                                       std::memory_order_relaxed);
+                return false;
+            }
+        }
+
+        slots[write & mask] = block;
+        producer.write.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: merges every pending block into summary (which is left as
+    // is when there are none) and returns how many there were
+    int drain(BlockTelemetry& summary)
+    {
+        const uint32_t read = consumer.read.load(std::memory_order_relaxed);
+        const uint32_t pending = producer.write.load(std::memory_order_acquire) - read;
+        for (uint32_t i = 0; i < pending; ++i)
+        {
+            if (i == 0)
+                summary = slots[read & mask];
+            else
+                summary.merge(slots[(read + i) & mask]);
+        }
+
+        consumer.read.store(read + pending, std::memory_order_release);
+        return static_cast<int>(pending);
+    }
+
+    // Consumer: drops whatever is pending, e.g. when an editor opens
+    void discard()
+    {
+        consumer.read.store(producer.write.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    // Pushes dropped because the queue was full
+    uint32_t getNumDropped() const { return producer.dropped.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint32_t mask = capacity - 1;
+    static_assert((capacity & mask) == 0, "capacity must be a power of two");
+
+    struct alignas(64) Producer
+    {
+        std::atomic<uint32_t> write { 0 };
+        uint32_t cachedRead = 0;
+        std::atomic<uint32_t> dropped { 0 };
+    };
+
+    struct alignas(64) Consumer
+    {
+        std::atomic<uint32_t> read { 0 };
+    };
+
+    std::array<BlockTelemetry, capacity> slots {};
+    Producer producer;
+    Consumer consumer;
+};
+
+} // namespace Chronos
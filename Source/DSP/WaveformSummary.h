@@ -0,0 +1,279 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+namespace Chronos {
+
+// Coarse min/max of everything written into the delay line: one bin per
+// binsPerSecond-th of a second, across all channels. The audio thread
+// fills bins into a fixed ring covering more than the longest delay;
+// WaveformPyramid reads them from another thread. Each bin is one 64-bit
+// atomic (min and max packed), so readers never see a torn bin, and the
+// ring itself is published with release/acquire, so a reader that starts
+// before the first prepare() sees either nothing or the whole ring.
+class WaveformSummary
+{
+public:
+    static constexpr int binsPerSecond = 750;           // 64 samples at 48 kHz
+    static constexpr int capacityBits = 16;             // 87 s of bins
+    static constexpr uint32_t capacity = 1u << capacityBits;
+
+    struct Bin
+    {
+        float min = 0.0f;
+        float max = 0.0f;
+    };
+
+    // Allocates the ring on first use; later calls only restart it. Not
+    // realtime safe.
+    void prepare(float sampleRate)
+    {
+        if (storage == nullptr)
+        {
+            storage = std::make_unique<std::atomic<uint64_t>[]>(capacity);
+            for (uint32_t i = 0; i < capacity; ++i)
+                storage[i].store(0, std::memory_order_relaxed);
+            bins.store(storage.get(), std::memory_order_release);
+        }
+
+        const int samplesPerBin = std::max(1, static_cast<int>(std::lround(sampleRate / binsPerSecond)));
+        binSamples.store(samplesPerBin, std::memory_order_relaxed);
+        binSeconds.store(static_cast<double>(samplesPerBin) / sampleRate, std::memory_order_relaxed);
+        reset();
+    }
+
+    // Call while not processing
+    void reset()
+    {
+        current = {};
+        currentFill = 0;
+        count.store(0, std::memory_order_relaxed);
+        generation.fetch_add(1, std::memory_order_release);
+    }
+
+    bool isPrepared() const { return bins.load(std::memory_order_acquire) != nullptr; }
+
+    // Audio thread: frames about to be written to the delay line
+    void write(const float* const* channels, int numChannels, int numSamples)
+    {
+        auto* ring = storage.get();  // Allocated on this thread's side of prepare()
+        if (ring == nullptr)
+            return;
+
+        const int samplesPerBin = binSamples.load(std::memory_order_relaxed);
+
+        for (int pos = 0; pos < numSamples;)
+        {
+            const int n = std::min(numSamples - pos, samplesPerBin - currentFill);
+
+            float lo = currentFill > 0 ? current.min : channels[0][pos];
+            float hi = currentFill > 0 ? current.max : channels[0][pos];
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                const float* x = channels[ch] + pos;
+                for (int i = 0; i < n; ++i)
+                {
+                    lo = std::min(lo, x[i]);
+                    hi = std::max(hi, x[i]);
+                }
+            }
+
+            current = { lo, hi };
+            currentFill += n;
+            pos += n;
+
+            if (currentFill == samplesPerBin)
+            {
+                const uint32_t index = count.load(std::memory_order_relaxed);
+                ring[index & (capacity - 1)].store(pack(current), std::memory_order_relaxed);
+                count.store(index + 1, std::memory_order_release);
+                currentFill = 0;
+            }
+        }
+    }
+
+    // Any thread
+    uint32_t getCount() const { return count.load(std::memory_order_acquire); }
+    uint32_t getGeneration() const { return generation.load(std::memory_order_acquire); }
+    double getBinSeconds() const { return binSeconds.load(std::memory_order_relaxed); }
+
+    // Bin i (of getCount()); valid while fewer than capacity bins newer.
+    // Only after isPrepared() has returned true.
+    Bin getBin(uint32_t index) const
+    {
+        const auto* ring = bins.load(std::memory_order_acquire);
+        return unpack(ring[index & (capacity - 1)].load(std::memory_order_relaxed));
+    }
+
+private:
+    static uint64_t pack(Bin bin)
+    {
+        uint32_t lo, hi;
+        std::memcpy(&lo, &bin.min, sizeof(lo));
+        std::memcpy(&hi, &bin.max, sizeof(hi));
+        return (static_cast<uint64_t>(hi) << 32) | lo;
+    }
+
+    static Bin unpack(uint64_t packed)
+    {
+        Bin bin;
+        const auto lo = static_cast<uint32_t>(packed);
+        const auto hi = static_cast<uint32_t>(packed >> 32);
+        std::memcpy(&bin.min, &lo, sizeof(lo));
+        std::memcpy(&bin.max, &hi, sizeof(hi));
+        return bin;
+    }
+
+    std::unique_ptr<std::atomic<uint64_t>[]> storage;  // Owner; written by prepare() only
+    std::atomic<std::atomic<uint64_t>*> bins { nullptr };  // Published view for readers
+    std::atomic<int> binSamples { 64 };
+    std::atomic<double> binSeconds { 64.0 / 48000.0 };
+    std::atomic<uint32_t> count { 0 };
+    std::atomic<uint32_t> generation { 0 };
+
+    // Bin being filled; audio thread only
+    Bin current;
+    int currentFill = 0;
+};
+
+// Min/max mipmap over a WaveformSummary: level 0 is the summary's bins and
+// each level above halves the resolution. update() folds in new bins
+// incrementally (a few entries per level per bin) and belongs on a
+// background thread; getColumns() reads at most a few entries per column
+// at the level that matches the zoom, so drawing costs O(pixels) whatever
+// the window length. The two may run on different threads.
+class WaveformPyramid
+{
+public:
+    static constexpr int numLevels = WaveformSummary::capacityBits - 4;  // Top level: 16 entries
+
+    using Bin = WaveformSummary::Bin;
+
+    WaveformPyramid()
+    {
+        for (int k = 0; k < numLevels; ++k)
+            levels[static_cast<size_t>(k)].resize(WaveformSummary::capacity >> k);
+    }
+
+    // Background thread; returns true when there were new bins
+    bool update(const WaveformSummary& summary)
+    {
+        if (!summary.isPrepared())
+            return false;
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        const uint32_t newGeneration = summary.getGeneration();
+        if (newGeneration != generation)
+        {
+            generation = newGeneration;
+            count = 0;
+            binSeconds = summary.getBinSeconds();
+            ++version;
+        }
+
+        const uint32_t available = summary.getCount();
+        if (available == count)
+            return false;
+
+        // Fell more than a ring behind: restart from the oldest bin still held
+        uint32_t next = count;
+        bool restart = count == 0;
+        if (available - next > WaveformSummary::capacity)
+        {
+            next = available - WaveformSummary::capacity;
+            restart = true;
+        }
+
+        for (; next != available; ++next, restart = false)
+        {
+            const Bin bin = summary.getBin(next);
+
+            for (int k = 0; k < numLevels; ++k)
+            {
+                auto& level = levels[static_cast<size_t>(k)];
+                auto& entry = level[(next >> k) & (level.size() - 1)];
+
+                // First bin of the entry restarts it
+                if (restart || (next & ((1u << k) - 1)) == 0)
+                    entry = bin;
+                else
+                    entry = { std::min(entry.min, bin.min), std::max(entry.max, bin.max) };
+            }
+        }
+
+        count = available;
+        ++version;
+        return true;
+    }
+
+    // Changes whenever there is something new to draw
+    uint32_t getVersion() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return version;
+    }
+
+    // Fills numColumns min/max pairs, column 0 ending at the newest sample
+    // and each column windowSeconds / numColumns further into the past.
+    // Columns older than the history held are left at 0.
+    void getColumns(double windowSeconds, int numColumns, Bin* columns) const
+    {
+        std::fill(columns, columns + numColumns, Bin {});
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (count == 0 || numColumns <= 0 || windowSeconds <= 0.0)
+            return;
+
+        const double binsPerColumn = windowSeconds / (binSeconds * numColumns);
+        const int64_t oldest = std::max<int64_t>(0, static_cast<int64_t>(count) - WaveformSummary::capacity);
+
+        // Level whose entries are no wider than a column
+        int k = 0;
+        while (k + 1 < numLevels && static_cast<double>(1u << (k + 1)) <= binsPerColumn)
+            ++k;
+
+        const auto& level = levels[static_cast<size_t>(k)];
+        const int64_t mask = static_cast<int64_t>(level.size()) - 1;
+
+        for (int c = 0; c < numColumns; ++c)
+        {
+            // Bins [first, last] of this column, at least one wide
+            const auto end = static_cast<int64_t>(count) - static_cast<int64_t>(std::floor(c * binsPerColumn));
+            const auto begin = std::min(end - 1, static_cast<int64_t>(count) - static_cast<int64_t>(std::floor((c + 1) * binsPerColumn)));
+            if (end <= oldest)
+                break;
+
+            // Entries at this level that overlap, skipping any partly reused
+            const int64_t firstEntry = begin >= oldest ? begin >> k : (oldest + (int64_t(1) << k) - 1) >> k;
+            const int64_t lastEntry = std::max(firstEntry, (end - 1) >> k);
+
+            Bin column = level[static_cast<size_t>(firstEntry & mask)];
+            for (int64_t e = firstEntry + 1; e <= lastEntry; ++e)
+            {
+                const Bin& entry = level[static_cast<size_t>(e & mask)];
+                column = { std::min(column.min, entry.min), std::max(column.max, entry.max) };
+            }
+
+            columns[c] = column;
+        }
+    }
+
+private:
+    mutable std::mutex mutex;
+    std::array<std::vector<Bin>, numLevels> levels;
+    uint32_t count = 0;         // Bins folded in so far
+    uint32_t generation = 0;
+    uint32_t version = 0;
+    double binSeconds = 64.0 / 48000.0;
+};
+
+} // namespace Chronos
@@ -1,7 +1,8 @@
 #include "PluginEditor.h"
 
 ChronosAudioProcessorEditor::ChronosAudioProcessorEditor(ChronosAudioProcessor& p)
-    : AudioProcessorEditor(&p), processorRef(p)
+    : AudioProcessorEditor(&p), processorRef(p),
+      waveformFeed(p.getWaveformSummary()), cpuMeter(p.getLoadMeter())
 {
     setLookAndFeel(&lookAndFeel);
 
@@ -10,8 +11,10 @@ ChronosAudioProcessorEditor::ChronosAudioProcessorEditor(ChronosAudioProcessor&
                                                  BinaryData::company_logo_pngSize);
 
     // Add visualizers
+    timeDisplay.setWaveform(&waveformFeed.getPyramid());
     addAndMakeVisible(timeDisplay);
     addAndMakeVisible(feedbackMeter);
+    addAndMakeVisible(cpuMeter);
 
     // Configure sliders as rotary
     auto setupRotarySlider = [this](juce::Slider& slider) {
@@ -28,6 +31,8 @@ ChronosAudioProcessorEditor::ChronosAudioProcessorEditor(ChronosAudioProcessor&
     addAndMakeVisible(syncDivisionCombo);
     linkLRButton.setButtonText("LINK");
     addAndMakeVisible(linkLRButton);
+    longDelayButton.setButtonText("LONG");
+    addAndMakeVisible(longDelayButton);
 
     // Feedback controls
     setupRotarySlider(feedbackSlider);
@@ -41,7 +46,7 @@ ChronosAudioProcessorEditor::ChronosAudioProcessorEditor(ChronosAudioProcessor&
     // Modulation controls
     setupRotarySlider(modRateSlider);
     setupRotarySlider(modDepthSlider);
-    modShapeCombo.addItemList({"Sine", "Triangle", "Random"}, 1);
+    modShapeCombo.addItemList({"Sine", "Triangle", "Random", "Smooth Random"}, 1);
     addAndMakeVisible(modShapeCombo);
     modSyncButton.setButtonText("SYNC");
     addAndMakeVisible(modSyncButton);
@@ -57,6 +62,9 @@ ChronosAudioProcessorEditor::ChronosAudioProcessorEditor(ChronosAudioProcessor&
     setupRotarySlider(duckAmountSlider);
     freezeButton.setButtonText("FREEZE");
     addAndMakeVisible(freezeButton);
+    multiTapButton.setButtonText("MULTI-TAP");
+    addAndMakeVisible(multiTapButton);
+    setupRotarySlider(tapCountSlider);
 
     // I/O controls
     setupRotarySlider(inputGainSlider);
@@ -79,10 +87,11 @@ ChronosAudioProcessorEditor::ChronosAudioProcessorEditor(ChronosAudioProcessor&
     // Attachments
     auto& apvts = processorRef.getAPVTS();
 
-    delayTimeAttachment = std::make_unique<SliderAttachment>(apvts, Chronos::ParamIDs::delayTime, delayTimeSlider);
     tempoSyncAttachment = std::make_unique<ButtonAttachment>(apvts, Chronos::ParamIDs::tempoSync, tempoSyncButton);
     syncDivisionAttachment = std::make_unique<ComboAttachment>(apvts, Chronos::ParamIDs::syncDivision, syncDivisionCombo);
     linkLRAttachment = std::make_unique<ButtonAttachment>(apvts, Chronos::ParamIDs::linkLR, linkLRButton);
+    longDelayAttachment = std::make_unique<ButtonAttachment>(apvts, Chronos::ParamIDs::longDelay, longDelayButton);
+    attachDelayTime(longDelayButton.getToggleState());
 
     feedbackAttachment = std::make_unique<SliderAttachment>(apvts, Chronos::ParamIDs::feedback, feedbackSlider);
     dampingAttachment = std::make_unique<SliderAttachment>(apvts, Chronos::ParamIDs::damping, dampingSlider);
@@ -102,13 +111,18 @@ ChronosAudioProcessorEditor::ChronosAudioProcessorEditor(ChronosAudioProcessor&
     duckingAttachment = std::make_unique<ButtonAttachment>(apvts, Chronos::ParamIDs::ducking, duckingButton);
     duckAmountAttachment = std::make_unique<SliderAttachment>(apvts, Chronos::ParamIDs::duckAmount, duckAmountSlider);
     freezeAttachment = std::make_unique<ButtonAttachment>(apvts, Chronos::ParamIDs::freeze, freezeButton);
+    multiTapAttachment = std::make_unique<ButtonAttachment>(apvts, Chronos::ParamIDs::multiTap, multiTapButton);
+    tapCountAttachment = std::make_unique<SliderAttachment>(apvts, Chronos::ParamIDs::tapCount, tapCountSlider);
 
     inputGainAttachment = std::make_unique<SliderAttachment>(apvts, Chronos::ParamIDs::inputGain, inputGainSlider);
     outputGainAttachment = std::make_unique<SliderAttachment>(apvts, Chronos::ParamIDs::outputGain, outputGainSlider);
     mixAttachment = std::make_unique<SliderAttachment>(apvts, Chronos::ParamIDs::mix, mixSlider);
 
+    // Blocks queued while no editor was open are stale
+    processorRef.getTelemetry().discard();
+
     setSize(800, 560);
-    startTimerHz(30);
+    frameClock = std::make_unique<Chronos::FrameClock::Attachment>(*this, *this);
 }
 
 ChronosAudioProcessorEditor::~ChronosAudioProcessorEditor()
@@ -157,8 +171,10 @@ void ChronosAudioProcessorEditor::resized()
 {
     auto area = getLocalBounds();
 
-    // Header
-    area.removeFromTop(50);
+    // Header: CPU meter left of the logo
+    auto headerArea = area.removeFromTop(50);
+    headerArea.removeFromRight(100);
+    cpuMeter.setBounds(headerArea.removeFromRight(110).reduced(0, 15));
 
     // Time display
     auto visualizerArea = area.removeFromTop(120).reduced(10);
@@ -182,6 +198,7 @@ void ChronosAudioProcessorEditor::resized()
     tempoSyncButton.setBounds(timeRow.removeFromLeft(70).reduced(5, 30));
     syncDivisionCombo.setBounds(timeRow.removeFromLeft(90).reduced(5, 35));
     linkLRButton.setBounds(timeRow.removeFromLeft(60).reduced(5, 30));
+    longDelayButton.setBounds(timeRow.removeFromLeft(60).reduced(5, 30));
 
     leftColumn.removeFromTop(15);
 
@@ -228,29 +245,58 @@ void ChronosAudioProcessorEditor::resized()
 
     outputRow.removeFromLeft(30);
     freezeButton.setBounds(outputRow.removeFromLeft(90).reduced(5, 18));
+
+    outputRow.removeFromLeft(20);
+    multiTapButton.setBounds(outputRow.removeFromLeft(80).reduced(5, 22));
+    tapCountSlider.setBounds(outputRow.removeFromLeft(knobSize));
 }
 
-void ChronosAudioProcessorEditor::timerCallback()
+void ChronosAudioProcessorEditor::attachDelayTime(bool longDelay)
 {
-    // Update visualizers with current processor state
-    timeDisplay.setDelayTime(delayTimeSlider.getValue());
-    timeDisplay.setFeedbackLevel(processorRef.getFeedbackLevel());
-    timeDisplay.setLFOPhase(processorRef.getLFOPhase());
-    timeDisplay.setModDepth(static_cast<float>(modDepthSlider.getValue()) / 100.0f);
-    timeDisplay.setTempoSync(tempoSyncButton.getToggleState());
-    timeDisplay.setBPM(processorRef.getCurrentBPM());
+    delayTimeAttachment.reset();
+    delayTimeAttachment = std::make_unique<SliderAttachment>(processorRef.getAPVTS(),
+                                                             longDelay ? Chronos::ParamIDs::delayTimeLong
+                                                                       : Chronos::ParamIDs::delayTime,
+                                                             delayTimeSlider);
+    delayTimeIsLong = longDelay;
+}
+
+void ChronosAudioProcessorEditor::frameTick()
+{
+    // The Long Delay switch may also be automated
+    if (longDelayButton.getToggleState() != delayTimeIsLong)
+        attachDelayTime(longDelayButton.getToggleState());
+
+    // Everything processed since the last frame; kept as is while the host
+    // is not processing
+    processorRef.getTelemetry().drain(telemetry);
+
+    // Update visualizers with current processor state; the waveform spans
+    // the synced delay rather than the free-running knob
+    float delayMs = static_cast<float>(delayTimeSlider.getValue());
+    const bool tempoSync = tempoSyncButton.getToggleState();
+    const int divIndex = syncDivisionCombo.getSelectedItemIndex();
 
-    if (tempoSyncButton.getToggleState())
+    if (tempoSync && divIndex >= 0)
     {
-        int divIndex = syncDivisionCombo.getSelectedItemIndex();
-        if (divIndex >= 0)
-            timeDisplay.setSyncDivisionName(Chronos::getDivisionName(static_cast<Chronos::SyncDivision>(divIndex)));
+        const auto division = static_cast<Chronos::SyncDivision>(divIndex);
+        timeDisplay.setSyncDivisionName(Chronos::getDivisionName(division));
+        delayMs = Chronos::calculateDelayMs(processorRef.getCurrentBPM(), division);
     }
 
-    feedbackMeter.setLevel(processorRef.getFeedbackLevel());
+    timeDisplay.setDelayTime(delayMs);
+    timeDisplay.refreshWaveform();
+    timeDisplay.setModDepth(static_cast<float>(modDepthSlider.getValue()) / 100.0f);
+    timeDisplay.setLFOPhase(telemetry.lfoPhase);
+    timeDisplay.setTempoSync(tempoSync);
+    timeDisplay.setBPM(processorRef.getCurrentBPM());
+
+    feedbackMeter.setLevel(telemetry.feedbackPeak);
+    feedbackMeter.advanceFrame();
+    cpuMeter.update();
 
     // Visual feedback for freeze state
-    if (freezeButton.getToggleState())
+    if (telemetry.frozen)
     {
         freezeButton.setColour(juce::TextButton::buttonOnColourId, Chronos::Colors::freezePurple);
     }
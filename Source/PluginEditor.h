@@ -5,10 +5,13 @@
 #include "UI/ChronosLookAndFeel.h"
 #include "UI/TimeDisplay.h"
 #include "UI/DelayMeter.h"
+#include "UI/CpuMeter.h"
+#include "UI/FrameClock.h"
+#include "UI/WaveformFeed.h"
 #include "Utils/Parameters.h"
 #include "BinaryData.h"
 
-class ChronosAudioProcessorEditor : public juce::AudioProcessorEditor, private juce::Timer
+class ChronosAudioProcessorEditor : public juce::AudioProcessorEditor, private Chronos::FrameClock::Client
 {
 public:
     explicit ChronosAudioProcessorEditor(ChronosAudioProcessor&);
@@ -18,7 +21,11 @@ public:
     void resized() override;
 
 private:
-    void timerCallback() override;
+    // Pulls telemetry into the visualizers; each repaints only what changed
+    void frameTick() override;
+
+    // Points the delay time knob at the 2 s or the 60 s parameter
+    void attachDelayTime(bool longDelay);
 
     ChronosAudioProcessor& processorRef;
     Chronos::ChronosLookAndFeel lookAndFeel;
@@ -26,15 +33,19 @@ private:
     // Header
     juce::Image logoImage;
 
-    // Visualizers
+    // Visualizers, fed from the processor's telemetry queue
+    Chronos::BlockTelemetry telemetry;
+    Chronos::WaveformFeed waveformFeed;
     Chronos::TimeDisplay timeDisplay;
     Chronos::DelayMeter feedbackMeter;
+    Chronos::CpuMeter cpuMeter;
 
     // Time controls
     juce::Slider delayTimeSlider;
     juce::ToggleButton tempoSyncButton;
     juce::ComboBox syncDivisionCombo;
     juce::ToggleButton linkLRButton;
+    juce::ToggleButton longDelayButton;
 
     // Feedback controls
     juce::Slider feedbackSlider;
@@ -58,6 +69,8 @@ private:
     juce::ToggleButton duckingButton;
     juce::Slider duckAmountSlider;
     juce::ToggleButton freezeButton;
+    juce::ToggleButton multiTapButton;
+    juce::Slider tapCountSlider;
 
     // I/O controls
     juce::Slider inputGainSlider;
@@ -79,6 +92,8 @@ private:
     std::unique_ptr<ButtonAttachment> tempoSyncAttachment;
     std::unique_ptr<ComboAttachment> syncDivisionAttachment;
     std::unique_ptr<ButtonAttachment> linkLRAttachment;
+    std::unique_ptr<ButtonAttachment> longDelayAttachment;
+    bool delayTimeIsLong = false;
 
     std::unique_ptr<SliderAttachment> feedbackAttachment;
     std::unique_ptr<SliderAttachment> dampingAttachment;
@@ -98,10 +113,15 @@ private:
     std::unique_ptr<ButtonAttachment> duckingAttachment;
     std::unique_ptr<SliderAttachment> duckAmountAttachment;
     std::unique_ptr<ButtonAttachment> freezeAttachment;
+    std::unique_ptr<ButtonAttachment> multiTapAttachment;
+    std::unique_ptr<SliderAttachment> tapCountAttachment;
 
     std::unique_ptr<SliderAttachment> inputGainAttachment;
     std::unique_ptr<SliderAttachment> outputGainAttachment;
     std::unique_ptr<SliderAttachment> mixAttachment;
 
+    // Declared last: ticks stop before anything above is destroyed
+    std::unique_ptr<Chronos::FrameClock::Attachment> frameClock;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChronosAudioProcessorEditor)
 };
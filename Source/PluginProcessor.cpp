@@ -1,5 +1,6 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "DSP/DecayEstimate.h"
 
 ChronosAudioProcessor::ChronosAudioProcessor()
     : AudioProcessor(BusesProperties()
@@ -8,10 +9,14 @@ ChronosAudioProcessor::ChronosAudioProcessor()
       apvts(*this, nullptr, "Parameters", Chronos::Parameters::createLayout()),
       params(apvts)
 {
+    delayEngine.setTelemetryEnabled(true);
+    startTimerHz(20);  // Delay-line page commits
 }
 
 ChronosAudioProcessor::~ChronosAudioProcessor()
 {
+    stopTimer();
+    cancelPendingUpdate();
 }
 
 const juce::String ChronosAudioProcessor::getName() const
@@ -36,7 +41,11 @@ bool ChronosAudioProcessor::isMidiEffect() const
 
 double ChronosAudioProcessor::getTailLengthSeconds() const
 {
-    return 2.0;  // Max delay time
+    // Until the repeats fall below the 16-bit floor; infinite while frozen or
+    // when the feedback need not decay
+    const auto engineParams = params.makeEngineParameters(getCurrentBPM(), isNonRealtime());
+    const double seconds = Chronos::estimateDecaySeconds(engineParams, -96.0f);
+    return seconds >= 0.0 ? seconds : std::numeric_limits<double>::infinity();
 }
 
 int ChronosAudioProcessor::getNumPrograms()
@@ -67,7 +76,35 @@ void ChronosAudioProcessor::changeProgramName(int index, const juce::String& new
 
 void ChronosAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
-    delayEngine.prepare(static_cast<float>(sampleRate), samplesPerBlock);
+    loadMeter.prepare(sampleRate);
+    prepareEngine(sampleRate, samplesPerBlock);
+}
+
+void ChronosAudioProcessor::prepareEngine(double sampleRate, int samplesPerBlock)
+{
+    delayEngine.prepare(static_cast<float>(sampleRate), samplesPerBlock, params.getDelayStorage(),
+                        Chronos::makeChannelLayout(getChannelLayoutOfBus(false, 0), channelOrder));
+}
+
+void ChronosAudioProcessor::handleAsyncUpdate()
+{
+    if (params.getDelayStorage() == delayEngine.getDelayStorage() || getSampleRate() <= 0.0)
+        return;
+
+    suspendProcessing(true);
+
+    // Out of memory for the new format: the engine is half prepared, so
+    // processing stays suspended rather than running on it
+    try
+    {
+        prepareEngine(getSampleRate(), getBlockSize());
+    }
+    catch (const std::bad_alloc&)
+    {
+        return;
+    }
+
+    suspendProcessing(false);
 }
 
 void ChronosAudioProcessor::releaseResources()
@@ -77,13 +114,13 @@ void ChronosAudioProcessor::releaseResources()
 
 bool ChronosAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
 {
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
-        return false;
+    // Any discrete layout up to the engine's width, same on both sides
+    const auto& output = layouts.getMainOutputChannelSet();
 
-    if (layouts.getMainInputChannelSet() != juce::AudioChannelSet::stereo())
+    if (output.isDisabled() || output.size() > Chronos::DelayEngine::maxChannels)
         return false;
 
-    return true;
+    return layouts.getMainInputChannelSet() == output;
 }
 
 void ChronosAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
@@ -91,6 +128,7 @@ void ChronosAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
     juce::ignoreUnused(midiMessages);
 
     juce::ScopedNoDenormals noDenormals;
+    Chronos::LoadMeter::ScopedTimer loadTimer(loadMeter, buffer.getNumSamples());
 
     // Get tempo from host
     if (auto* playHead = getPlayHead())
@@ -98,74 +136,36 @@ void ChronosAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
         if (auto posInfo = playHead->getPosition())
         {
             if (posInfo->getBpm().hasValue())
-                currentBPM = static_cast<float>(*posInfo->getBpm());
+                currentBPM.store(static_cast<float>(*posInfo->getBpm()), std::memory_order_relaxed);
         }
     }
 
-    // Build engine parameters from APVTS
-    Chronos::DelayEngine::Parameters engineParams;
+    delayEngine.setParameters(params.makeEngineParameters(currentBPM.load(std::memory_order_relaxed), isNonRealtime()));
 
-    // Time
-    bool tempoSyncEnabled = params.tempoSync->load() > 0.5f;
-    bool linkLR = params.linkLR->load() > 0.5f;
+    // The storage format is applied by re-preparing off the audio thread
+    if (params.getDelayStorage() != delayEngine.getDelayStorage())
+        triggerAsyncUpdate();
 
-    if (tempoSyncEnabled)
-    {
-        auto division = static_cast<Chronos::SyncDivision>(static_cast<int>(params.syncDivision->load()));
-        engineParams.delayTimeMs = Chronos::calculateDelayMs(currentBPM, division);
-        engineParams.delayTimeRightMs = engineParams.delayTimeMs;
-    }
-    else
-    {
-        engineParams.delayTimeMs = params.delayTime->load();
-        engineParams.delayTimeRightMs = linkLR ? engineParams.delayTimeMs : params.delayTimeR->load();
-    }
-
-    // Feedback
-    engineParams.feedback = params.feedback->load() / 100.0f;
-    engineParams.filterFreq = params.fbFilterFreq->load();
-    engineParams.filterRes = params.fbFilterRes->load() / 100.0f;
-    engineParams.filterMode = static_cast<Chronos::FilterMode>(static_cast<int>(params.fbFilterMode->load()));
-    engineParams.damping = params.damping->load() / 100.0f;
-    engineParams.drive = params.drive->load() / 100.0f;
-
-    // Modulation
-    bool modSyncEnabled = params.modSync->load() > 0.5f;
-    if (modSyncEnabled)
-    {
-        auto modDiv = static_cast<Chronos::SyncDivision>(static_cast<int>(params.modSyncDiv->load()));
-        engineParams.modRateHz = Chronos::calculateLFORateHz(currentBPM, modDiv);
-    }
-    else
-    {
-        engineParams.modRateHz = params.modRate->load();
-    }
-    engineParams.modDepth = params.modDepth->load() / 100.0f;
-
-    // Set LFO shape
-    delayEngine.setLFOShape(static_cast<Chronos::LFOShape>(static_cast<int>(params.modShape->load())));
-
-    // Stereo
-    engineParams.stereoMode = static_cast<Chronos::StereoMode>(static_cast<int>(params.stereoMode->load()));
-    engineParams.width = params.width->load() / 100.0f;
+    // Process audio, in the engine's channel order
+    const auto& layout = delayEngine.getChannelLayout();
+    if (buffer.getNumChannels() < layout.numChannels)
+        return;
 
-    // Features
-    engineParams.duckingEnabled = params.ducking->load() > 0.5f;
-    engineParams.duckAmount = params.duckAmount->load() / 100.0f;
-    engineParams.freeze = params.freeze->load() > 0.5f;
+    float* channels[Chronos::DelayEngine::maxChannels];
+    for (int ch = 0; ch < layout.numChannels; ++ch)
+        channels[ch] = buffer.getWritePointer(channelOrder[static_cast<size_t>(ch)]);
 
-    // I/O (convert dB to linear)
-    engineParams.inputGain = juce::Decibels::decibelsToGain(params.inputGain->load());
-    engineParams.outputGain = juce::Decibels::decibelsToGain(params.outputGain->load());
-    engineParams.mix = params.mix->load() / 100.0f;
+    delayEngine.process(channels, buffer.getNumSamples());
+    telemetry.push(delayEngine.getBlockTelemetry());
 
-    delayEngine.setParameters(engineParams);
-
-    // Process audio
-    auto* leftChannel = buffer.getWritePointer(0);
-    auto* rightChannel = buffer.getWritePointer(1);
+    // Offline renders may outrun the message thread's timer
+    if (isNonRealtime())
+        delayEngine.serviceDelayMemory();
+}
 
-    delayEngine.process(leftChannel, rightChannel, buffer.getNumSamples());
+void ChronosAudioProcessor::timerCallback()
+{
+    delayEngine.serviceDelayMemory();
 }
 
 bool ChronosAudioProcessor::hasEditor() const
@@ -2,10 +2,15 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include "DSP/DelayEngine.h"
+#include "DSP/LoadMeter.h"
+#include "DSP/Telemetry.h"
+#include "Utils/ChannelMapping.h"
 #include "Utils/Parameters.h"
 #include "Utils/TempoSync.h"
 
-class ChronosAudioProcessor : public juce::AudioProcessor
+class ChronosAudioProcessor : public juce::AudioProcessor,
+                              private juce::AsyncUpdater,
+                              private juce::Timer
 {
 public:
     ChronosAudioProcessor();
@@ -39,17 +44,34 @@ public:
 
     juce::AudioProcessorValueTreeState& getAPVTS() { return apvts; }
 
-    // For UI metering
-    float getFeedbackLevel() const { return delayEngine.getFeedbackLevel(); }
-    float getLFOPhase() const { return delayEngine.getLFOValue(); }
-    float getCurrentBPM() const { return currentBPM; }
+    // For UI metering: one BlockTelemetry per processed block, drained by
+    // the editor (the single consumer)
+    Chronos::TelemetryFifo& getTelemetry() { return telemetry; }
+    const Chronos::WaveformSummary& getWaveformSummary() const { return delayEngine.getWaveformSummary(); }
+    float getCurrentBPM() const { return currentBPM.load(std::memory_order_relaxed); }
+
+    // Time spent in processBlock, against the real-time budget
+    Chronos::LoadMeter& getLoadMeter() { return loadMeter; }
 
 private:
+    // Engine layout follows the output bus; see Chronos::makeChannelLayout
+    void prepareEngine(double sampleRate, int samplesPerBlock);
+
+    // Re-prepares the engine when Delay Memory changes while playing
+    void handleAsyncUpdate() override;
+
+    // Commits delay-line pages as the delay time grows (and frees them)
+    void timerCallback() override;
+
     juce::AudioProcessorValueTreeState apvts;
     Chronos::Parameters params;
     Chronos::DelayEngine delayEngine;
+    Chronos::LoadMeter loadMeter;
+    Chronos::TelemetryFifo telemetry;
+
+    Chronos::ChannelOrder channelOrder {};
 
-    float currentBPM = 120.0f;
+    std::atomic<float> currentBPM { 120.0f };
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChronosAudioProcessor)
 };
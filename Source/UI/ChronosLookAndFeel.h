@@ -1,6 +1,9 @@
 #pragma once
 
 #include <juce_gui_basics/juce_gui_basics.h>
+#include <map>
+#include <tuple>
+#include <vector>
 
 namespace Chronos {
 
@@ -25,50 +28,38 @@ struct Colors
     static inline const juce::Colour meterRed        = juce::Colour(0xffff4444);
 };
 
-class ChronosLookAndFeel : public juce::LookAndFeel_V4
+// Pre-rendered rotary knobs: one filmstrip per knob diameter, pixel scale
+// and rotary range, with a frame per pixel or so of travel at the rim.
+// Frames are rendered from paths the first time they are drawn. Shared by
+// every editor in the process through juce::SharedResourcePointer; message
+// thread only.
+class KnobFilmstrips
 {
 public:
-    ChronosLookAndFeel()
-    {
-        setColour(juce::Slider::backgroundColourId, Colors::panelDark);
-        setColour(juce::Slider::trackColourId, Colors::timeBlue.withAlpha(0.4f));
-        setColour(juce::Slider::thumbColourId, Colors::timeBlue);
-        setColour(juce::Slider::rotarySliderFillColourId, Colors::timeBlue);
-        setColour(juce::Slider::rotarySliderOutlineColourId, Colors::panelDark);
-
-        setColour(juce::Label::textColourId, Colors::textPrimary);
-
-        setColour(juce::ComboBox::backgroundColourId, Colors::panelDark);
-        setColour(juce::ComboBox::textColourId, Colors::textPrimary);
-        setColour(juce::ComboBox::outlineColourId, Colors::timeBlue.withAlpha(0.3f));
-        setColour(juce::ComboBox::arrowColourId, Colors::timeBlue);
+    static constexpr int minFrames = 32;
+    static constexpr int maxFrames = 192;
+    static constexpr size_t maxStrips = 16;  // Least recently used beyond this are dropped
 
-        setColour(juce::PopupMenu::backgroundColourId, Colors::panelDark);
-        setColour(juce::PopupMenu::textColourId, Colors::textPrimary);
-        setColour(juce::PopupMenu::highlightedBackgroundColourId, Colors::timeBlue.withAlpha(0.3f));
-        setColour(juce::PopupMenu::highlightedTextColourId, Colors::textPrimary);
+    const juce::Image& getFrame(float diameter, float scale, float startAngle, float endAngle, float sliderPos)
+    {
+        auto& strip = getStrip(diameter, scale, startAngle, endAngle);
+        const int index = juce::jlimit(0, static_cast<int>(strip.frames.size()) - 1,
+                                       juce::roundToInt(sliderPos * static_cast<float>(strip.frames.size() - 1)));
 
-        setColour(juce::ToggleButton::textColourId, Colors::textPrimary);
-        setColour(juce::ToggleButton::tickColourId, Colors::timeBlue);
-        setColour(juce::ToggleButton::tickDisabledColourId, Colors::textSecondary);
+        auto& frame = strip.frames[static_cast<size_t>(index)];
+        if (!frame.isValid())
+            frame = renderFrame(strip, static_cast<float>(index) / static_cast<float>(strip.frames.size() - 1));
 
-        setColour(juce::TextButton::buttonColourId, Colors::panelLight);
-        setColour(juce::TextButton::buttonOnColourId, Colors::timeBlue);
-        setColour(juce::TextButton::textColourOffId, Colors::textPrimary);
-        setColour(juce::TextButton::textColourOnId, Colors::background);
+        return frame;
     }
 
-    void drawRotarySlider(juce::Graphics& g, int x, int y, int width, int height,
-                          float sliderPos, float rotaryStartAngle, float rotaryEndAngle,
-                          juce::Slider& slider) override
+    // Vector rendering; bounds is the knob's square
+    static void paintKnob(juce::Graphics& g, juce::Rectangle<float> bounds,
+                          float sliderPos, float rotaryStartAngle, float rotaryEndAngle)
     {
-        auto bounds = juce::Rectangle<int>(x, y, width, height).toFloat().reduced(4.0f);
         auto radius = juce::jmin(bounds.getWidth(), bounds.getHeight()) / 2.0f;
         auto centreX = bounds.getCentreX();
         auto centreY = bounds.getCentreY();
-        auto rx = centreX - radius;
-        auto ry = centreY - radius;
-        auto rw = radius * 2.0f;
         auto angle = rotaryStartAngle + sliderPos * (rotaryEndAngle - rotaryStartAngle);
 
         // Background arc
@@ -103,6 +94,132 @@ public:
         g.fillEllipse(centreX - 6.0f, centreY - 6.0f, 12.0f, 12.0f);
     }
 
+private:
+    struct Key
+    {
+        int sizePx;             // Frame edge in physical pixels
+        int scaleMilli;
+        int startMilli, endMilli;
+
+        bool operator<(const Key& other) const
+        {
+            return std::tie(sizePx, scaleMilli, startMilli, endMilli)
+                 < std::tie(other.sizePx, other.scaleMilli, other.startMilli, other.endMilli);
+        }
+    };
+
+    struct Strip
+    {
+        float diameter = 0.0f;  // Logical
+        float scale = 1.0f;
+        float startAngle = 0.0f, endAngle = 0.0f;
+        std::vector<juce::Image> frames;
+        juce::uint64 lastUse = 0;
+    };
+
+    Strip& getStrip(float diameter, float scale, float startAngle, float endAngle)
+    {
+        // A pixel of margin round the knob for antialiasing
+        const Key key { static_cast<int>(std::ceil((diameter + 2.0f) * scale)), juce::roundToInt(scale * 1000.0f),
+                        juce::roundToInt(startAngle * 1000.0f), juce::roundToInt(endAngle * 1000.0f) };
+
+        auto it = strips.find(key);
+        if (it == strips.end())
+        {
+            if (strips.size() >= maxStrips)
+                strips.erase(std::min_element(strips.begin(), strips.end(), [](const auto& a, const auto& b)
+                                              { return a.second.lastUse < b.second.lastUse; }));
+
+            Strip strip;
+            strip.diameter = diameter;
+            strip.scale = scale;
+            strip.startAngle = startAngle;
+            strip.endAngle = endAngle;
+
+            const float travelPx = std::abs(endAngle - startAngle) * 0.5f * diameter * scale;
+            strip.frames.resize(static_cast<size_t>(juce::jlimit(minFrames, maxFrames, juce::roundToInt(travelPx) + 1)));
+
+            it = strips.emplace(key, std::move(strip)).first;
+        }
+
+        it->second.lastUse = ++useCounter;
+        return it->second;
+    }
+
+    static juce::Image renderFrame(const Strip& strip, float sliderPos)
+    {
+        const int sizePx = static_cast<int>(std::ceil((strip.diameter + 2.0f) * strip.scale));
+        juce::Image frame(juce::Image::ARGB, sizePx, sizePx, true);
+
+        juce::Graphics g(frame);
+        g.addTransform(juce::AffineTransform::scale(strip.scale));
+
+        const float size = static_cast<float>(sizePx) / strip.scale;
+        paintKnob(g, juce::Rectangle<float>(strip.diameter, strip.diameter).withCentre({ size * 0.5f, size * 0.5f }),
+                  sliderPos, strip.startAngle, strip.endAngle);
+        return frame;
+    }
+
+    std::map<Key, Strip> strips;
+    juce::uint64 useCounter = 0;
+};
+
+class ChronosLookAndFeel : public juce::LookAndFeel_V4
+{
+public:
+    ChronosLookAndFeel()
+    {
+        setColour(juce::Slider::backgroundColourId, Colors::panelDark);
+        setColour(juce::Slider::trackColourId, Colors::timeBlue.withAlpha(0.4f));
+        setColour(juce::Slider::thumbColourId, Colors::timeBlue);
+        setColour(juce::Slider::rotarySliderFillColourId, Colors::timeBlue);
+        setColour(juce::Slider::rotarySliderOutlineColourId, Colors::panelDark);
+
+        setColour(juce::Label::textColourId, Colors::textPrimary);
+
+        setColour(juce::ComboBox::backgroundColourId, Colors::panelDark);
+        setColour(juce::ComboBox::textColourId, Colors::textPrimary);
+        setColour(juce::ComboBox::outlineColourId, Colors::timeBlue.withAlpha(0.3f));
+        setColour(juce::ComboBox::arrowColourId, Colors::timeBlue);
+
+        setColour(juce::PopupMenu::backgroundColourId, Colors::panelDark);
+        setColour(juce::PopupMenu::textColourId, Colors::textPrimary);
+        setColour(juce::PopupMenu::highlightedBackgroundColourId, Colors::timeBlue.withAlpha(0.3f));
+        setColour(juce::PopupMenu::highlightedTextColourId, Colors::textPrimary);
+
+        setColour(juce::ToggleButton::textColourId, Colors::textPrimary);
+        setColour(juce::ToggleButton::tickColourId, Colors::timeBlue);
+        setColour(juce::ToggleButton::tickDisabledColourId, Colors::textSecondary);
+
+        setColour(juce::TextButton::buttonColourId, Colors::panelLight);
+        setColour(juce::TextButton::buttonOnColourId, Colors::timeBlue);
+        setColour(juce::TextButton::textColourOffId, Colors::textPrimary);
+        setColour(juce::TextButton::textColourOnId, Colors::background);
+    }
+
+    // Composites the knob from a cached filmstrip frame; paths are only
+    // rasterized the first time a frame is needed at this size and scale
+    void drawRotarySlider(juce::Graphics& g, int x, int y, int width, int height,
+                          float sliderPos, float rotaryStartAngle, float rotaryEndAngle,
+                          juce::Slider&) override
+    {
+        auto bounds = juce::Rectangle<int>(x, y, width, height).toFloat().reduced(4.0f);
+        const float diameter = juce::jmin(bounds.getWidth(), bounds.getHeight());
+        if (diameter <= 0.0f)
+            return;
+
+        const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        const auto& frame = knobs->getFrame(diameter, scale, rotaryStartAngle, rotaryEndAngle, sliderPos);
+
+        // Logical size of the frame, placed on the physical pixel grid so it
+        // is copied rather than resampled
+        const float size = static_cast<float>(frame.getWidth()) / scale;
+        const float left = std::round((bounds.getCentreX() - size * 0.5f) * scale) / scale;
+        const float top = std::round((bounds.getCentreY() - size * 0.5f) * scale) / scale;
+
+        g.drawImage(frame, juce::Rectangle<float>(left, top, size, size));
+    }
+
     void drawButtonBackground(juce::Graphics& g, juce::Button& button,
                               const juce::Colour& backgroundColour,
                               bool shouldDrawButtonAsHighlighted,
@@ -164,6 +281,9 @@ public:
                          juce::jmax(1, static_cast<int>(static_cast<float>(textArea.getHeight()) / 12.0f)),
                          label.getMinimumHorizontalScale());
     }
+
+private:
+    juce::SharedResourcePointer<KnobFilmstrips> knobs;
 };
 
 } // namespace Chronos
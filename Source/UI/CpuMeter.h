@@ -0,0 +1,93 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "ChronosLookAndFeel.h"
+#include "../DSP/LoadMeter.h"
+
+namespace Chronos {
+
+// This instance's share of the audio callback budget: smoothed average as a
+// bar, worst block since the last reset as a tick. Clicking copies the full LoadMeter report to the
+// clipboard (and the log); shift-click also resets the statistics.
+class CpuMeter : public juce::Component
+{
+public:
+    explicit CpuMeter(LoadMeter& meterToShow) : meter(meterToShow)
+    {
+        setOpaque(true);
+        setMouseCursor(juce::MouseCursor::PointingHandCursor);
+        setTitle("DSP load");
+        setDescription("Click to copy the load report; shift-click to reset");
+    }
+
+    // Call once per editor frame
+    void update()
+    {
+        const auto snapshot = meter.getSnapshot();
+
+        // Repaint only when the readout would change
+        const int newTenths = juce::roundToInt(snapshot.averageLoad * 1000.0f);
+        const int newPeakTenths = juce::roundToInt(snapshot.peakLoad * 1000.0f);
+        if (newTenths != shownTenths || newPeakTenths != shownPeakTenths)
+        {
+            shownTenths = newTenths;
+            shownPeakTenths = newPeakTenths;
+            repaint();
+        }
+    }
+
+    void paint(juce::Graphics& g) override
+    {
+        g.fillAll(Colors::panelDark);
+
+        auto bounds = getLocalBounds().toFloat().reduced(1.0f);
+        const float load = static_cast<float>(shownTenths) / 1000.0f;
+        const float peak = static_cast<float>(shownPeakTenths) / 1000.0f;
+
+        g.setColour(Colors::panelDark.darker(0.3f));
+        g.fillRoundedRectangle(bounds, 3.0f);
+
+        // Bar, full scale at 100% of the budget
+        auto barBounds = bounds.reduced(2.0f);
+        auto fill = barBounds.withWidth(barBounds.getWidth() * std::clamp(load, 0.0f, 1.0f));
+
+        if (load < 0.5f)
+            g.setColour(Colors::meterGreen.withAlpha(0.5f));
+        else if (load < 0.8f)
+            g.setColour(Colors::meterYellow.withAlpha(0.6f));
+        else
+            g.setColour(Colors::meterRed.withAlpha(0.7f));
+        g.fillRoundedRectangle(fill, 2.0f);
+
+        if (peak > 0.0f)
+        {
+            const float peakX = barBounds.getX() + barBounds.getWidth() * std::clamp(peak, 0.0f, 1.0f);
+            g.setColour(Colors::textPrimary.withAlpha(0.7f));
+            g.fillRect(peakX - 1.0f, barBounds.getY(), 2.0f, barBounds.getHeight());
+        }
+
+        g.setFont(juce::Font(11.0f));
+        g.setColour(Colors::textPrimary);
+        g.drawText("CPU " + juce::String(100.0f * load, 1) + "%", bounds, juce::Justification::centred);
+
+        g.setColour(Colors::timeBlue.withAlpha(0.3f));
+        g.drawRoundedRectangle(bounds, 3.0f, 1.0f);
+    }
+
+    void mouseUp(const juce::MouseEvent& e) override
+    {
+        const auto report = juce::String(meter.dump());
+        juce::SystemClipboard::copyTextToClipboard(report);
+        juce::Logger::writeToLog(report);
+
+        if (e.mods.isShiftDown())
+            meter.reset();
+    }
+
+private:
+    LoadMeter& meter;
+    int shownTenths = 0;        // Average, in tenths of a percent
+    int shownPeakTenths = 0;    // Worst block since the last reset
+};
+
+} // namespace Chronos
@@ -6,25 +6,26 @@
 
 namespace Chronos {
 
-class DelayMeter : public juce::Component, private juce::Timer
+// Vertical level meter with peak hold. Animation advances in advanceFrame(),
+// called from the editor's frame clock; only the rows whose fill or peak
+// marker moved are repainted. The frame and border are cached as an image.
+class DelayMeter : public juce::Component
 {
 public:
     DelayMeter()
     {
-        startTimerHz(30);
+        setOpaque(true);
     }
 
     void paint(juce::Graphics& g) override
     {
-        auto bounds = getLocalBounds().toFloat().reduced(2.0f);
+        const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        if (!background.isValid() || scale != backgroundScale)
+            renderBackground(scale);
 
-        // Background
-        g.setColour(Colors::panelDark);
-        g.fillRoundedRectangle(bounds, 4.0f);
+        g.drawImage(background, getLocalBounds().toFloat());
 
-        // Meter area
-        auto meterBounds = bounds.reduced(3.0f);
-        float meterHeight = meterBounds.getHeight() * smoothedLevel;
+        auto meterBounds = getMeterBounds();
 
         // Gradient fill based on level
         juce::Colour meterColour;
@@ -36,23 +37,24 @@ public:
             meterColour = Colors::meterRed;
 
         // Draw meter from bottom up
-        auto fillBounds = meterBounds;
-        fillBounds.removeFromTop(meterBounds.getHeight() - meterHeight);
+        auto fillBounds = meterBounds.withTop(static_cast<float>(fillTop));
 
         g.setColour(meterColour);
         g.fillRoundedRectangle(fillBounds, 2.0f);
 
         // Peak indicator
-        if (peakLevel > 0.01f)
+        if (peakY >= 0)
         {
-            float peakY = meterBounds.getBottom() - meterBounds.getHeight() * peakLevel;
             g.setColour(Colors::textPrimary);
-            g.fillRect(meterBounds.getX(), peakY - 1.0f, meterBounds.getWidth(), 2.0f);
+            g.fillRect(meterBounds.getX(), static_cast<float>(peakY) - 1.0f, meterBounds.getWidth(), 2.0f);
         }
+    }
 
-        // Border
-        g.setColour(Colors::timeBlue.withAlpha(0.3f));
-        g.drawRoundedRectangle(bounds, 4.0f, 1.0f);
+    void resized() override
+    {
+        background = {};
+        fillTop = juce::roundToInt(getMeterBounds().getBottom());
+        peakY = -1;
     }
 
     void setLevel(float level)
@@ -66,8 +68,8 @@ public:
         }
     }
 
-private:
-    void timerCallback() override
+    // One animation frame at FrameClock::frameRateHz
+    void advanceFrame()
     {
         // Smooth the level display
         float targetLevel = currentLevel;
@@ -86,7 +88,69 @@ private:
             peakLevel *= 0.95f;
         }
 
-        repaint();
+        // Repaint the rows that changed, in whole pixels
+        const auto meterBounds = getMeterBounds();
+        const int newFillTop = juce::roundToInt(meterBounds.getBottom() - meterBounds.getHeight() * smoothedLevel);
+        const int newPeakY = peakLevel > 0.01f
+                           ? juce::roundToInt(meterBounds.getBottom() - meterBounds.getHeight() * peakLevel) : -1;
+        const int newBand = smoothedLevel < 0.6f ? 0 : (smoothedLevel < 0.85f ? 1 : 2);
+
+        if (newBand != colourBand)
+        {
+            repaint(meterBounds.toNearestIntEdges());
+        }
+        else
+        {
+            // Rounded fill corners reach a couple of pixels past the edge
+            if (newFillTop != fillTop)
+                repaintRows(std::min(newFillTop, fillTop) - 3, std::max(newFillTop, fillTop) + 3);
+            if (newPeakY != peakY)
+            {
+                if (peakY >= 0)
+                    repaintRows(peakY - 2, peakY + 2);
+                if (newPeakY >= 0)
+                    repaintRows(newPeakY - 2, newPeakY + 2);
+            }
+        }
+
+        fillTop = newFillTop;
+        peakY = newPeakY;
+        colourBand = newBand;
+    }
+
+private:
+    juce::Rectangle<float> getMeterBounds() const
+    {
+        return getLocalBounds().toFloat().reduced(2.0f).reduced(3.0f);
+    }
+
+    void repaintRows(int top, int bottom)
+    {
+        const auto meter = getMeterBounds().toNearestIntEdges();
+        repaint(meter.getX(), top, meter.getWidth(), bottom - top);
+    }
+
+    // Editor background, panel and border, at the display's pixel density
+    void renderBackground(float scale)
+    {
+        backgroundScale = scale;
+        background = juce::Image(juce::Image::RGB,
+                                 std::max(1, juce::roundToInt(static_cast<float>(getWidth()) * scale)),
+                                 std::max(1, juce::roundToInt(static_cast<float>(getHeight()) * scale)), false);
+
+        juce::Graphics g(background);
+        g.addTransform(juce::AffineTransform::scale(scale));
+        g.fillAll(Colors::background);
+
+        auto bounds = getLocalBounds().toFloat().reduced(2.0f);
+
+        // Background
+        g.setColour(Colors::panelDark);
+        g.fillRoundedRectangle(bounds, 4.0f);
+
+        // Border
+        g.setColour(Colors::timeBlue.withAlpha(0.3f));
+        g.drawRoundedRectangle(bounds, 4.0f, 1.0f);
     }
 
     float currentLevel = 0.0f;
@@ -94,6 +158,14 @@ private:
     float peakLevel = 0.0f;
     int peakHoldCounter = 0;
     static constexpr int peakHoldTime = 30;  // ~1 second at 30Hz
+
+    // What was last painted, in component pixels
+    int fillTop = 0;
+    int peakY = -1;
+    int colourBand = 0;
+
+    juce::Image background;
+    float backgroundScale = 0.0f;
 };
 
 } // namespace Chronos
@@ -0,0 +1,4 @@
+#include "FrameClock.h"
+
+// Implementation is header-only
+// This file exists for build system compatibility
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+namespace Chronos {
+
+// One frame clock for every open Chronos editor in the process, shared
+// through juce::SharedResourcePointer. Each editor attaches a
+// FrameClock::Attachment, which listens to its window's vblank; the first
+// vblank of each frame period ticks all clients at once and the rest are
+// ignored. Forty open editors cost one pass per frame, aligned to the
+// display, instead of forty free-running timers. Message thread only.
+class FrameClock
+{
+public:
+    static constexpr double frameRateHz = 30.0;
+
+    struct Client
+    {
+        virtual ~Client() = default;
+        virtual void frameTick() = 0;
+    };
+
+    // Registers client for the attachment's lifetime and drives the clock
+    // from the vblank of component's window
+    class Attachment
+    {
+    public:
+        Attachment(juce::Component& component, Client& clientToTick)
+            : client(clientToTick),
+              vblank(&component, [this] { clock->vblank(); })
+        {
+            clock->clients.add(&client);
+        }
+
+        ~Attachment() { clock->clients.remove(&client); }
+
+        Attachment(const Attachment&) = delete;
+        Attachment& operator=(const Attachment&) = delete;
+
+    private:
+        juce::SharedResourcePointer<FrameClock> clock;
+        Client& client;
+        juce::VBlankAttachment vblank;
+    };
+
+private:
+    void vblank()
+    {
+        // Half a 120 Hz refresh of slack, so a 60 Hz display ticks every
+        // other vblank rather than drifting to every third
+        const double now = juce::Time::getMillisecondCounterHiRes() * 0.001;
+        if (now - lastTick < 1.0 / frameRateHz - 0.5 / 120.0)
+            return;
+
+        lastTick = now;
+        clients.call([](Client& c) { c.frameTick(); });
+    }
+
+    juce::ListenerList<Client> clients;
+    double lastTick = 0.0;
+};
+
+} // namespace Chronos
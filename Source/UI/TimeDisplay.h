@@ -2,136 +2,297 @@
 
 #include <juce_gui_basics/juce_gui_basics.h>
 #include "ChronosLookAndFeel.h"
+#include "../DSP/WaveformSummary.h"
 #include <array>
+#include <vector>
 #include <cmath>
 
 namespace Chronos {
 
-class TimeDisplay : public juce::Component, private juce::Timer
+// Delay time readout over the delay line's contents and the LFO wave. The
+// waveform spans one delay time, newest at the left and the echo about to
+// play at the right, drawn from a WaveformPyramid one column per pixel.
+// Setters repaint only the region whose content changed (waveform, LFO
+// band, time or BPM text) and only when it would move by a visible amount.
+// The panel, border and baseline are cached as an image, and the LFO wave
+// is a cached two-period path scrolled by the phase.
+class TimeDisplay : public juce::Component
 {
 public:
     TimeDisplay()
     {
-        startTimerHz(30);
+        setOpaque(true);
     }
 
     void paint(juce::Graphics& g) override
     {
+        const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        if (!background.isValid() || scale != backgroundScale)
+            renderBackground(scale);
+
+        g.drawImage(background, getLocalBounds().toFloat());
+
         auto bounds = getLocalBounds().toFloat().reduced(2.0f);
+        auto timelineArea = getTimelineArea();
+        float lineY = timelineArea.getCentreY();
 
-        // Background
-        g.setColour(Colors::panelDark);
-        g.fillRoundedRectangle(bounds, 6.0f);
+        // Delay line contents, one min/max column per pixel
+        if (waveform != nullptr && g.clipRegionIntersects(getWaveformArea()))
+        {
+            const int numColumns = juce::roundToInt(timelineArea.getWidth());
+            columns.resize(static_cast<size_t>(std::max(numColumns, 0)));
+            waveform->getColumns(delayTimeMs / 1000.0, numColumns, columns.data());
 
-        // Border
-        g.setColour(Colors::timeBlue.withAlpha(0.3f));
-        g.drawRoundedRectangle(bounds, 6.0f, 1.0f);
+            const float halfHeight = timelineArea.getHeight() * 0.5f;
+            g.setColour(Colors::timeBlue.withAlpha(0.6f));
 
-        // Draw timeline
-        auto timelineArea = bounds.reduced(20.0f, 30.0f);
+            for (int x = 0; x < numColumns; ++x)
+            {
+                const auto& column = columns[static_cast<size_t>(x)];
+                const float top = lineY - std::clamp(column.max, -1.0f, 1.0f) * halfHeight;
+                const float bottom = lineY - std::clamp(column.min, -1.0f, 1.0f) * halfHeight;
+                g.fillRect(timelineArea.getX() + static_cast<float>(x), top, 1.0f, std::max(bottom - top, 1.0f));
+            }
+        }
 
-        // Timeline base line
-        float lineY = timelineArea.getCentreY();
-        g.setColour(Colors::textSecondary.withAlpha(0.3f));
-        g.drawLine(timelineArea.getX(), lineY, timelineArea.getRight(), lineY, 1.0f);
+        // LFO modulation wave overlay, scrolled by the phase
+        if (modDepth > 0.01f && g.clipRegionIntersects(getLFOArea()))
+        {
+            if (lfoPathWidth != timelineArea.getWidth() || lfoPathDepth != modDepth)
+                buildLFOPath(timelineArea);
 
-        // Draw delay taps (visualize feedback decay)
-        float tapX = timelineArea.getX() + 20.0f;
-        float spacing = (timelineArea.getWidth() - 40.0f) / 6.0f;
+            juce::Graphics::ScopedSaveState state(g);
+            g.reduceClipRegion(getLFOArea());
+            g.setColour(Colors::modCyan.withAlpha(0.4f));
+            g.strokePath(lfoPath, juce::PathStrokeType(2.0f),
+                         juce::AffineTransform::translation(timelineArea.getX() - lfoPhase * timelineArea.getWidth(), lineY));
+        }
 
-        for (int i = 0; i < 6; ++i)
+        // Delay time readout
+        if (g.clipRegionIntersects(getTimeTextArea()))
         {
-            float decay = std::pow(feedbackLevel, static_cast<float>(i + 1));
-            float alpha = 0.2f + decay * 0.8f;
-            float height = 10.0f + decay * 30.0f;
+            g.setFont(juce::Font(16.0f).boldened());
+            g.setColour(Colors::textPrimary);
+            g.drawText(timeText, bounds.reduced(10.0f).removeFromTop(24.0f),
+                       juce::Justification::centred);
+        }
 
-            // Tap marker
-            g.setColour(Colors::timeBlue.withAlpha(alpha));
-            g.fillRoundedRectangle(tapX + i * spacing - 3.0f, lineY - height / 2.0f,
-                                   6.0f, height, 2.0f);
+        // BPM display if tempo sync
+        if (tempoSync && g.clipRegionIntersects(getBPMTextArea()))
+        {
+            g.setFont(juce::Font(11.0f));
+            g.setColour(Colors::textSecondary);
+            g.drawText(bpmText, bounds.reduced(10.0f).removeFromBottom(18.0f),
+                       juce::Justification::centred);
+        }
+    }
 
-            // Glow effect on first tap
-            if (i == 0)
-            {
-                for (int glow = 3; glow >= 0; --glow)
-                {
-                    g.setColour(Colors::timeBlue.withAlpha(0.05f * (4 - glow)));
-                    g.fillEllipse(tapX - 8.0f - glow * 2.0f, lineY - 8.0f - glow * 2.0f,
-                                  16.0f + glow * 4.0f, 16.0f + glow * 4.0f);
-                }
-            }
+    void resized() override
+    {
+        background = {};
+        lfoPathWidth = -1.0f;
+    }
+
+    void setDelayTime(float ms)
+    {
+        if (ms != delayTimeMs)
+        {
+            delayTimeMs = ms;
+            updateTimeText();
+            repaint(getWaveformArea());
         }
+    }
 
-        // Draw LFO modulation wave overlay
-        if (modDepth > 0.01f)
+    // Source of the delay line contents; nullptr hides the waveform
+    void setWaveform(const WaveformPyramid* pyramid)
+    {
+        waveform = pyramid;
+        waveformVersion = 0;
+        repaint(getWaveformArea());
+    }
+
+    // Once per frame: repaints the waveform if new audio has been folded in
+    void refreshWaveform()
+    {
+        if (waveform == nullptr)
+            return;
+
+        const auto version = waveform->getVersion();
+        if (version != waveformVersion)
         {
-            juce::Path lfoPath;
-            float waveHeight = timelineArea.getHeight() * 0.3f * modDepth;
+            waveformVersion = version;
+            repaint(getWaveformArea());
+        }
+    }
 
-            for (float x = 0.0f; x < timelineArea.getWidth(); x += 2.0f)
-            {
-                float phase = (x / timelineArea.getWidth()) * 2.0f * 3.14159265359f + lfoPhase * 2.0f * 3.14159265359f;
-                float y = lineY + std::sin(phase) * waveHeight;
+    void setLFOPhase(float phase)
+    {
+        // Repaint once the wave has scrolled by half a pixel
+        const float width = getTimelineArea().getWidth();
+        if (modDepth > 0.01f && std::abs(phase - lfoPhase) * width >= 0.5f)
+        {
+            lfoPhase = phase;
+            repaint(getLFOArea());
+        }
+    }
 
-                if (x == 0.0f)
-                    lfoPath.startNewSubPath(timelineArea.getX() + x, y);
-                else
-                    lfoPath.lineTo(timelineArea.getX() + x, y);
-            }
+    void setModDepth(float depth)
+    {
+        if (depth != modDepth)
+        {
+            // The band to clear is the larger of the old and new waves
+            repaint(getLFOArea());
+            modDepth = depth;
+            repaint(getLFOArea());
+        }
+    }
 
-            g.setColour(Colors::modCyan.withAlpha(0.4f));
-            g.strokePath(lfoPath, juce::PathStrokeType(2.0f));
+    void setTempoSync(bool sync)
+    {
+        if (sync != tempoSync)
+        {
+            tempoSync = sync;
+            updateTimeText();
+            repaint(getBPMTextArea());
+        }
+    }
+
+    void setSyncDivisionName(const juce::String& name)
+    {
+        if (name != syncDivisionName)
+        {
+            syncDivisionName = name;
+            updateTimeText();
         }
+    }
 
-        // Delay time readout
-        g.setFont(juce::Font(16.0f).boldened());
-        g.setColour(Colors::textPrimary);
+    void setBPM(float bpmValue)
+    {
+        auto text = juce::String(bpmValue, 1) + " BPM";
+        if (text != bpmText)
+        {
+            bpmText = text;
+            if (tempoSync)
+                repaint(getBPMTextArea());
+        }
+    }
+
+private:
+    juce::Rectangle<float> getTimelineArea() const
+    {
+        return getLocalBounds().toFloat().reduced(2.0f).reduced(20.0f, 30.0f);
+    }
+
+    // Dirty regions, with a pixel of margin for antialiasing
+    juce::Rectangle<int> getWaveformArea() const
+    {
+        return getTimelineArea().expanded(1.0f).toNearestIntEdges();
+    }
+
+    juce::Rectangle<int> getLFOArea() const
+    {
+        auto timelineArea = getTimelineArea();
+        const float waveHeight = timelineArea.getHeight() * 0.3f * modDepth;
+        return timelineArea.withSizeKeepingCentre(timelineArea.getWidth() + 2.0f, 2.0f * waveHeight + 4.0f)
+                           .toNearestIntEdges();
+    }
+
+    juce::Rectangle<int> getTimeTextArea() const
+    {
+        return getLocalBounds().toFloat().reduced(12.0f).removeFromTop(24.0f).toNearestIntEdges();
+    }
 
-        juce::String timeText;
+    juce::Rectangle<int> getBPMTextArea() const
+    {
+        return getLocalBounds().toFloat().reduced(12.0f).removeFromBottom(18.0f).toNearestIntEdges();
+    }
+
+    void updateTimeText()
+    {
+        juce::String text;
         if (tempoSync && !syncDivisionName.isEmpty())
         {
-            timeText = syncDivisionName + " (" + juce::String(static_cast<int>(delayTimeMs)) + " ms)";
+            text = syncDivisionName + " (" + juce::String(static_cast<int>(delayTimeMs)) + " ms)";
         }
         else
         {
-            timeText = juce::String(delayTimeMs, 1) + " ms";
+            text = juce::String(delayTimeMs, 1) + " ms";
         }
 
-        g.drawText(timeText, bounds.reduced(10.0f).removeFromTop(24.0f),
-                   juce::Justification::centred);
-
-        // BPM display if tempo sync
-        if (tempoSync)
+        if (text != timeText)
         {
-            g.setFont(juce::Font(11.0f));
-            g.setColour(Colors::textSecondary);
-            g.drawText(juce::String(bpm, 1) + " BPM",
-                       bounds.reduced(10.0f).removeFromBottom(18.0f),
-                       juce::Justification::centred);
+            timeText = text;
+            repaint(getTimeTextArea());
         }
     }
 
-    void setDelayTime(float ms) { delayTimeMs = ms; }
-    void setFeedbackLevel(float level) { feedbackLevel = level; }
-    void setLFOPhase(float phase) { lfoPhase = phase; }
-    void setModDepth(float depth) { modDepth = depth; }
-    void setTempoSync(bool sync) { tempoSync = sync; }
-    void setSyncDivisionName(const juce::String& name) { syncDivisionName = name; }
-    void setBPM(float bpmValue) { bpm = bpmValue; }
+    // Two periods of the wave from x = 0, centred on y = 0
+    void buildLFOPath(juce::Rectangle<float> timelineArea)
+    {
+        lfoPathWidth = timelineArea.getWidth();
+        lfoPathDepth = modDepth;
+        lfoPath.clear();
 
-private:
-    void timerCallback() override
+        float waveHeight = timelineArea.getHeight() * 0.3f * modDepth;
+
+        for (float x = 0.0f; x <= 2.0f * lfoPathWidth; x += 2.0f)
+        {
+            float y = std::sin((x / lfoPathWidth) * 2.0f * 3.14159265359f) * waveHeight;
+
+            if (x == 0.0f)
+                lfoPath.startNewSubPath(x, y);
+            else
+                lfoPath.lineTo(x, y);
+        }
+    }
+
+    // Panel, border and timeline baseline
+    void renderBackground(float scale)
     {
-        repaint();
+        backgroundScale = scale;
+        background = juce::Image(juce::Image::RGB,
+                                 std::max(1, juce::roundToInt(static_cast<float>(getWidth()) * scale)),
+                                 std::max(1, juce::roundToInt(static_cast<float>(getHeight()) * scale)), false);
+
+        juce::Graphics g(background);
+        g.addTransform(juce::AffineTransform::scale(scale));
+        g.fillAll(Colors::background);
+
+        auto bounds = getLocalBounds().toFloat().reduced(2.0f);
+
+        // Background
+        g.setColour(Colors::panelDark);
+        g.fillRoundedRectangle(bounds, 6.0f);
+
+        // Border
+        g.setColour(Colors::timeBlue.withAlpha(0.3f));
+        g.drawRoundedRectangle(bounds, 6.0f, 1.0f);
+
+        // Timeline base line
+        auto timelineArea = getTimelineArea();
+        float lineY = timelineArea.getCentreY();
+        g.setColour(Colors::textSecondary.withAlpha(0.3f));
+        g.drawLine(timelineArea.getX(), lineY, timelineArea.getRight(), lineY, 1.0f);
     }
 
     float delayTimeMs = 250.0f;
-    float feedbackLevel = 0.3f;
     float lfoPhase = 0.0f;
     float modDepth = 0.0f;
     bool tempoSync = false;
     juce::String syncDivisionName;
-    float bpm = 120.0f;
+    juce::String timeText { "250.0 ms" };
+    juce::String bpmText { "120.0 BPM" };
+
+    juce::Image background;
+    float backgroundScale = 0.0f;
+
+    const WaveformPyramid* waveform = nullptr;
+    uint32_t waveformVersion = 0;
+    std::vector<WaveformPyramid::Bin> columns;
+
+    juce::Path lfoPath;
+    float lfoPathWidth = -1.0f;
+    float lfoPathDepth = 0.0f;
 };
 
 } // namespace Chronos
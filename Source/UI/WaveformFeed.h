@@ -0,0 +1,44 @@
+#pragma once
+
+#include <juce_events/juce_events.h>
+#include "../DSP/WaveformSummary.h"
+
+namespace Chronos {
+
+// Keeps a WaveformPyramid up to date with an engine's WaveformSummary on a
+// background thread shared by every open editor, so neither the audio nor
+// the message thread pays for the folding.
+class WaveformFeed : private juce::TimeSliceClient
+{
+public:
+    explicit WaveformFeed(const WaveformSummary& summaryToFollow) : summary(summaryToFollow)
+    {
+        thread->addTimeSliceClient(this);
+    }
+
+    ~WaveformFeed() override
+    {
+        thread->removeTimeSliceClient(this);
+    }
+
+    const WaveformPyramid& getPyramid() const { return pyramid; }
+
+private:
+    struct BackgroundThread : juce::TimeSliceThread
+    {
+        BackgroundThread() : juce::TimeSliceThread("Chronos waveform") { startThread(juce::Thread::Priority::low); }
+        ~BackgroundThread() override { stopThread(1000); }
+    };
+
+    int useTimeSlice() override
+    {
+        pyramid.update(summary);
+        return 15;  // About two updates per frame
+    }
+
+    const WaveformSummary& summary;
+    WaveformPyramid pyramid;
+    juce::SharedResourcePointer<BackgroundThread> thread;
+};
+
+} // namespace Chronos
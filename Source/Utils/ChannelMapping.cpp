@@ -0,0 +1,54 @@
+#include "ChannelMapping.h"
+
+namespace Chronos {
+
+ChannelLayout makeChannelLayout(const juce::AudioChannelSet& set, ChannelOrder& order)
+{
+    using CT = juce::AudioChannelSet::ChannelType;
+    static constexpr std::pair<CT, CT> pairs[] = {
+        { CT::left, CT::right },
+        { CT::leftSurround, CT::rightSurround },
+        { CT::leftSurroundSide, CT::rightSurroundSide },
+        { CT::leftSurroundRear, CT::rightSurroundRear },
+        { CT::wideLeft, CT::wideRight },
+        { CT::leftCentre, CT::rightCentre },
+        { CT::topFrontLeft, CT::topFrontRight },
+        { CT::topSideLeft, CT::topSideRight },
+        { CT::topRearLeft, CT::topRearRight }
+    };
+
+    const int numChannels = std::min(set.size(), DelayEngine::maxChannels);
+
+    ChannelLayout layout;
+    layout.numChannels = std::max(numChannels, 1);
+    layout.numPairs = 0;
+
+    std::array<bool, DelayEngine::maxChannels> used {};
+    int next = 0;
+
+    for (const auto& [first, second] : pairs)
+    {
+        int a = set.getChannelIndexForType(first);
+        int b = set.getChannelIndexForType(second);
+        if (a < 0 || b < 0 || a >= numChannels || b >= numChannels)
+            continue;
+
+        order[static_cast<size_t>(next++)] = a;
+        order[static_cast<size_t>(next++)] = b;
+        used[static_cast<size_t>(a)] = used[static_cast<size_t>(b)] = true;
+        ++layout.numPairs;
+    }
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        if (!used[static_cast<size_t>(ch)])
+            order[static_cast<size_t>(next++)] = ch;
+    }
+
+    if (next == 0)
+        order[0] = 0;
+
+    return layout;
+}
+
+} // namespace Chronos
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "../DSP/DelayEngine.h"
+#include <array>
+
+namespace Chronos {
+
+// Engine channel -> buffer channel
+using ChannelOrder = std::array<int, DelayEngine::maxChannels>;
+
+// Engine layout for a channel set: paired channels (L/R, Ls/Rs, ...) first,
+// then the singles (C, LFE, ...); fills order to match
+ChannelLayout makeChannelLayout(const juce::AudioChannelSet& set, ChannelOrder& order);
+
+} // namespace Chronos
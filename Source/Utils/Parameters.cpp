@@ -48,6 +48,36 @@ juce::AudioProcessorValueTreeState::ParameterLayout Parameters::createLayout()
         true
     ));
 
+    // Delays up to 60 s use their own parameters, so automation recorded
+    // against the 2 s Delay Time keeps its mapping
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID(ParamIDs::longDelay, 1),
+        "Long Delay",
+        false
+    ));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID(ParamIDs::delayTimeLong, 1),
+        "Delay Time (Long)",
+        juce::NormalisableRange<float>(1.0f, 60000.0f, 0.1f, 0.2f),  // Skewed for ms, centre ~1.9 s
+        250.0f,
+        juce::String(),
+        juce::AudioProcessorParameter::genericParameter,
+        [](float value, int) { return juce::String(value, 1) + " ms"; },
+        nullptr
+    ));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID(ParamIDs::delayTimeLongR, 1),
+        "Delay Time R (Long)",
+        juce::NormalisableRange<float>(1.0f, 60000.0f, 0.1f, 0.2f),
+        250.0f,
+        juce::String(),
+        juce::AudioProcessorParameter::genericParameter,
+        [](float value, int) { return juce::String(value, 1) + " ms"; },
+        nullptr
+    ));
+
     // === FEEDBACK ===
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         juce::ParameterID(ParamIDs::feedback, 1),
@@ -141,7 +171,7 @@ juce::AudioProcessorValueTreeState::ParameterLayout Parameters::createLayout()
     params.push_back(std::make_unique<juce::AudioParameterChoice>(
         juce::ParameterID(ParamIDs::modShape, 1),
         "Mod Shape",
-        juce::StringArray{"Sine", "Triangle", "Random"},
+        juce::StringArray{"Sine", "Triangle", "Random", "Smooth Random"},
         0
     ));
 
@@ -201,6 +231,82 @@ juce::AudioProcessorValueTreeState::ParameterLayout Parameters::createLayout()
         false
     ));
 
+    // === MULTI-TAP ===
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID(ParamIDs::multiTap, 1),
+        "Multi-Tap",
+        false
+    ));
+
+    params.push_back(std::make_unique<juce::AudioParameterInt>(
+        juce::ParameterID(ParamIDs::tapCount, 1),
+        "Tap Count",
+        1, maxTaps,
+        4
+    ));
+
+    for (int tap = 0; tap < maxTaps; ++tap)
+    {
+        const juce::String name = "Tap " + juce::String(tap + 1) + " ";
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID(ParamIDs::tapTime(tap), 1),
+            name + "Time",
+            juce::NormalisableRange<float>(1.0f, 60000.0f, 0.1f, 0.2f),
+            125.0f * static_cast<float>(tap + 1),  // Evenly spaced eighths at 120 BPM
+            juce::String(),
+            juce::AudioProcessorParameter::genericParameter,
+            [](float value, int) { return juce::String(value, 1) + " ms"; },
+            nullptr
+        ));
+
+        params.push_back(std::make_unique<juce::AudioParameterChoice>(
+            juce::ParameterID(ParamIDs::tapDivision(tap), 1),
+            name + "Division",
+            getDivisionNames(),
+            std::min(3 + tap, static_cast<int>(SyncDivision::NumDivisions) - 1)  // 1/16 upward
+        ));
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID(ParamIDs::tapLevel(tap), 1),
+            name + "Level",
+            juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f),
+            100.0f,
+            juce::String(),
+            juce::AudioProcessorParameter::genericParameter,
+            [](float value, int) { return juce::String(static_cast<int>(value)) + "%"; },
+            nullptr
+        ));
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID(ParamIDs::tapPan(tap), 1),
+            name + "Pan",
+            juce::NormalisableRange<float>(-100.0f, 100.0f, 0.1f),
+            0.0f,
+            juce::String(),
+            juce::AudioProcessorParameter::genericParameter,
+            [](float value, int) {
+                if (value < 0.0f)
+                    return juce::String(static_cast<int>(-value)) + "L";
+                if (value > 0.0f)
+                    return juce::String(static_cast<int>(value)) + "R";
+                return juce::String("C");
+            },
+            nullptr
+        ));
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID(ParamIDs::tapFeedback(tap), 1),
+            name + "Feedback",
+            juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f),
+            tap == 0 ? 100.0f : 0.0f,  // First tap recirculates, like the single delay
+            juce::String(),
+            juce::AudioProcessorParameter::genericParameter,
+            [](float value, int) { return juce::String(static_cast<int>(value)) + "%"; },
+            nullptr
+        ));
+    }
+
     // === I/O ===
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         juce::ParameterID(ParamIDs::inputGain, 1),
@@ -235,6 +341,37 @@ juce::AudioProcessorValueTreeState::ParameterLayout Parameters::createLayout()
         nullptr
     ));
 
+    // === QUALITY ===
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID(ParamIDs::satAccuracy, 1),
+        "Saturation Accuracy",
+        juce::StringArray{"Auto", "Exact", "High", "Fast"},
+        0  // Auto: High while playing, Exact when rendering offline
+    ));
+
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID(ParamIDs::oversampling, 1),
+        "Oversampling",
+        juce::StringArray{"Off", "2x", "4x"},
+        1  // Default: 2x
+    ));
+
+    // Off by default: control rate saves CPU but does not match audio rate exactly
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID(ParamIDs::lfoControlRate, 1),
+        "Control-Rate LFO",
+        false
+    ));
+
+    // Reallocates the delay line, so it is not automatable
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID(ParamIDs::delayMemory, 1),
+        "Delay Memory",
+        juce::StringArray{"32-bit Float", "16-bit Half", "16-bit Dithered"},
+        0,
+        juce::AudioParameterChoiceAttributes().withAutomatable(false)
+    ));
+
     return { params.begin(), params.end() };
 }
 
@@ -245,6 +382,9 @@ Parameters::Parameters(juce::AudioProcessorValueTreeState& apvts)
     syncDivision    = apvts.getRawParameterValue(ParamIDs::syncDivision);
     delayTimeR      = apvts.getRawParameterValue(ParamIDs::delayTimeR);
     linkLR          = apvts.getRawParameterValue(ParamIDs::linkLR);
+    longDelay       = apvts.getRawParameterValue(ParamIDs::longDelay);
+    delayTimeLong   = apvts.getRawParameterValue(ParamIDs::delayTimeLong);
+    delayTimeLongR  = apvts.getRawParameterValue(ParamIDs::delayTimeLongR);
 
     feedback        = apvts.getRawParameterValue(ParamIDs::feedback);
     fbFilterFreq    = apvts.getRawParameterValue(ParamIDs::fbFilterFreq);
@@ -266,9 +406,118 @@ Parameters::Parameters(juce::AudioProcessorValueTreeState& apvts)
     duckAmount      = apvts.getRawParameterValue(ParamIDs::duckAmount);
     freeze          = apvts.getRawParameterValue(ParamIDs::freeze);
 
+    multiTap        = apvts.getRawParameterValue(ParamIDs::multiTap);
+    tapCount        = apvts.getRawParameterValue(ParamIDs::tapCount);
+    for (int tap = 0; tap < maxTaps; ++tap)
+    {
+        auto& t = taps[static_cast<size_t>(tap)];
+        t.time      = apvts.getRawParameterValue(ParamIDs::tapTime(tap));
+        t.division  = apvts.getRawParameterValue(ParamIDs::tapDivision(tap));
+        t.level     = apvts.getRawParameterValue(ParamIDs::tapLevel(tap));
+        t.pan       = apvts.getRawParameterValue(ParamIDs::tapPan(tap));
+        t.feedback  = apvts.getRawParameterValue(ParamIDs::tapFeedback(tap));
+    }
+
     inputGain       = apvts.getRawParameterValue(ParamIDs::inputGain);
     outputGain      = apvts.getRawParameterValue(ParamIDs::outputGain);
     mix             = apvts.getRawParameterValue(ParamIDs::mix);
+
+    satAccuracy     = apvts.getRawParameterValue(ParamIDs::satAccuracy);
+    oversampling    = apvts.getRawParameterValue(ParamIDs::oversampling);
+    lfoControlRate  = apvts.getRawParameterValue(ParamIDs::lfoControlRate);
+    delayMemory     = apvts.getRawParameterValue(ParamIDs::delayMemory);
+}
+
+DelayEngine::Parameters Parameters::makeEngineParameters(float bpm, bool nonRealtime) const
+{
+    DelayEngine::Parameters engineParams;
+
+    // Time
+    bool tempoSyncEnabled = tempoSync->load() > 0.5f;
+    bool linkEnabled = linkLR->load() > 0.5f;
+
+    if (tempoSyncEnabled)
+    {
+        auto division = static_cast<SyncDivision>(static_cast<int>(syncDivision->load()));
+        engineParams.delayTimeMs = calculateDelayMs(bpm, division);
+        engineParams.delayTimeRightMs = engineParams.delayTimeMs;
+    }
+    else
+    {
+        const bool longEnabled = longDelay->load() > 0.5f;
+        engineParams.delayTimeMs = (longEnabled ? delayTimeLong : delayTime)->load();
+        engineParams.delayTimeRightMs = linkEnabled ? engineParams.delayTimeMs
+                                                    : (longEnabled ? delayTimeLongR : delayTimeR)->load();
+    }
+
+    // Feedback
+    engineParams.feedback = feedback->load() / 100.0f;
+    engineParams.filterFreq = fbFilterFreq->load();
+    engineParams.filterRes = fbFilterRes->load() / 100.0f;
+    engineParams.filterMode = static_cast<FilterMode>(static_cast<int>(fbFilterMode->load()));
+    engineParams.damping = damping->load() / 100.0f;
+    engineParams.drive = drive->load() / 100.0f;
+
+    // Modulation
+    bool modSyncEnabled = modSync->load() > 0.5f;
+    if (modSyncEnabled)
+    {
+        auto modDiv = static_cast<SyncDivision>(static_cast<int>(modSyncDiv->load()));
+        engineParams.modRateHz = calculateLFORateHz(bpm, modDiv);
+    }
+    else
+    {
+        engineParams.modRateHz = modRate->load();
+    }
+    engineParams.modDepth = modDepth->load() / 100.0f;
+
+    engineParams.lfoShape = static_cast<LFOShape>(static_cast<int>(modShape->load()));
+    engineParams.lfoControlRate = lfoControlRate->load() > 0.5f;  // Bounces too, so they match playback
+
+    // Stereo
+    engineParams.stereoMode = static_cast<StereoMode>(static_cast<int>(stereoMode->load()));
+    engineParams.width = width->load() / 100.0f;
+
+    // Features
+    engineParams.duckingEnabled = ducking->load() > 0.5f;
+    engineParams.duckAmount = duckAmount->load() / 100.0f;
+    engineParams.freeze = freeze->load() > 0.5f;
+
+    // Multi-tap: tap times follow the tempo like the main delay time
+    static_assert(maxTaps == MAX_TAPS, "tap parameters must cover every engine tap");
+    engineParams.multiTap = multiTap->load() > 0.5f;
+    engineParams.numTaps = static_cast<int>(tapCount->load());
+    for (size_t tap = 0; tap < engineParams.taps.size(); ++tap)
+    {
+        const auto& source = taps[tap];
+        auto& dest = engineParams.taps[tap];
+
+        if (tempoSyncEnabled)
+            dest.timeMs = calculateDelayMs(bpm, static_cast<SyncDivision>(static_cast<int>(source.division->load())));
+        else
+            dest.timeMs = source.time->load();
+
+        dest.level = source.level->load() / 100.0f;
+        dest.pan = source.pan->load() / 100.0f;
+        dest.feedback = source.feedback->load() / 100.0f;
+    }
+
+    // I/O (convert dB to linear)
+    engineParams.inputGain = juce::Decibels::decibelsToGain(inputGain->load());
+    engineParams.outputGain = juce::Decibels::decibelsToGain(outputGain->load());
+    engineParams.mix = mix->load() / 100.0f;
+
+    // Offline bounces get the high-quality interpolator
+    engineParams.nonRealtime = nonRealtime;
+    engineParams.saturationAccuracy = static_cast<SaturationAccuracy>(static_cast<int>(satAccuracy->load()));
+    engineParams.oversampling = 1 << static_cast<int>(oversampling->load());  // Off, 2x, 4x
+
+    return engineParams;
+}
+
+DelayStorage Parameters::getDelayStorage() const
+{
+    return static_cast<DelayStorage>(static_cast<int>(delayMemory->load()));
 }
 
 } // namespace Chronos
@@ -2,6 +2,8 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include "TempoSync.h"
+#include "../DSP/DelayEngine.h"
+#include <array>
 
 namespace Chronos {
 
@@ -12,6 +14,9 @@ namespace ParamIDs {
     inline const juce::String syncDivision    = "syncDivision";
     inline const juce::String delayTimeR      = "delayTimeR";
     inline const juce::String linkLR          = "linkLR";
+    inline const juce::String longDelay       = "longDelay";
+    inline const juce::String delayTimeLong   = "delayTimeLong";
+    inline const juce::String delayTimeLongR  = "delayTimeLongR";
 
     // Feedback
     inline const juce::String feedback        = "feedback";
@@ -37,26 +42,51 @@ namespace ParamIDs {
     inline const juce::String duckAmount      = "duckAmount";
     inline const juce::String freeze          = "freeze";
 
+    // Multi-tap (tap is 0-based; IDs are tap1Time ... tap16Feedback)
+    inline const juce::String multiTap        = "multiTap";
+    inline const juce::String tapCount        = "tapCount";
+    inline juce::String tapTime(int tap)      { return "tap" + juce::String(tap + 1) + "Time"; }
+    inline juce::String tapDivision(int tap)  { return "tap" + juce::String(tap + 1) + "Division"; }
+    inline juce::String tapLevel(int tap)     { return "tap" + juce::String(tap + 1) + "Level"; }
+    inline juce::String tapPan(int tap)       { return "tap" + juce::String(tap + 1) + "Pan"; }
+    inline juce::String tapFeedback(int tap)  { return "tap" + juce::String(tap + 1) + "Feedback"; }
+
     // I/O
     inline const juce::String inputGain       = "inputGain";
     inline const juce::String outputGain      = "outputGain";
     inline const juce::String mix             = "mix";
+
+    // Quality
+    inline const juce::String satAccuracy     = "satAccuracy";
+    inline const juce::String oversampling    = "oversampling";
+    inline const juce::String lfoControlRate  = "lfoControlRate";
+    inline const juce::String delayMemory     = "delayMemory";
 }
 
 class Parameters
 {
 public:
+    static constexpr int maxTaps = 16;
+
     static juce::AudioProcessorValueTreeState::ParameterLayout createLayout();
 
     // Attach to APVTS
     explicit Parameters(juce::AudioProcessorValueTreeState& apvts);
 
+    // Engine settings from the current values; bpm drives the synced times,
+    // nonRealtime selects the offline quality settings
+    DelayEngine::Parameters makeEngineParameters(float bpm, bool nonRealtime) const;
+    DelayStorage getDelayStorage() const;
+
     // Raw parameter pointers for fast access
     std::atomic<float>* delayTime       = nullptr;
     std::atomic<float>* tempoSync       = nullptr;
     std::atomic<float>* syncDivision    = nullptr;
     std::atomic<float>* delayTimeR      = nullptr;
     std::atomic<float>* linkLR          = nullptr;
+    std::atomic<float>* longDelay       = nullptr;
+    std::atomic<float>* delayTimeLong   = nullptr;
+    std::atomic<float>* delayTimeLongR  = nullptr;
 
     std::atomic<float>* feedback        = nullptr;
     std::atomic<float>* fbFilterFreq    = nullptr;
@@ -78,9 +108,27 @@ public:
     std::atomic<float>* duckAmount      = nullptr;
     std::atomic<float>* freeze          = nullptr;
 
+    struct TapParams
+    {
+        std::atomic<float>* time        = nullptr;
+        std::atomic<float>* division    = nullptr;
+        std::atomic<float>* level       = nullptr;
+        std::atomic<float>* pan         = nullptr;
+        std::atomic<float>* feedback    = nullptr;
+    };
+
+    std::atomic<float>* multiTap        = nullptr;
+    std::atomic<float>* tapCount        = nullptr;
+    std::array<TapParams, maxTaps> taps;
+
     std::atomic<float>* inputGain       = nullptr;
     std::atomic<float>* outputGain      = nullptr;
     std::atomic<float>* mix             = nullptr;
+
+    std::atomic<float>* satAccuracy     = nullptr;
+    std::atomic<float>* oversampling    = nullptr;
+    std::atomic<float>* lfoControlRate  = nullptr;
+    std::atomic<float>* delayMemory     = nullptr;
 };
 
 } // namespace Chronos
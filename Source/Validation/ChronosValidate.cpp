@@ -0,0 +1,702 @@
+// Golden-reference validation: renders a fixed corpus through the per-sample
+// reference (DelayEngine::processScalar with Hermite reads, exact tanh and an
+// audio-rate LFO) and through each optimized path, then compares them. Also
+// checks that oversampling keeps the repeats of a driven feedback loop on
+// time. Exits non-zero when any comparison is outside its path's bounds.
+//
+//   chronos_validate [--filter text] [--max-abs x] [--max-rms-db x]
+//                    [--max-spectral-db x] [--max-decay-ms x]
+
+#include "DelayEngine.h"
+#include "DelayEngineBank.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__SSE__) || defined(_M_X64)
+ #include <xmmintrin.h>
+#endif
+
+using namespace Chronos;
+
+namespace {
+
+constexpr float sampleRate = 48000.0f;
+constexpr int blockSize = 256;
+constexpr unsigned int lfoSeed = 0x5eed;
+constexpr double pi = 3.14159265358979323846;
+
+using Channels = std::vector<std::vector<float>>;
+
+// === Corpus ===
+
+struct Signal
+{
+    std::string name;
+    Channels channels;      // Stereo; input followed by silence for the tail
+    int inputLength = 0;
+};
+
+Signal makeSignal(const std::string& name, double inputSeconds, const std::function<void(Channels&, int)>& fill)
+{
+    constexpr double tailSeconds = 4.0;
+
+    Signal signal;
+    signal.name = name;
+    signal.inputLength = static_cast<int>(inputSeconds * sampleRate);
+
+    const auto total = static_cast<size_t>((inputSeconds + tailSeconds) * sampleRate);
+    signal.channels.assign(2, std::vector<float>(total, 0.0f));
+    fill(signal.channels, signal.inputLength);
+    return signal;
+}
+
+std::vector<Signal> makeCorpus()
+{
+    std::vector<Signal> corpus;
+
+    corpus.push_back(makeSignal("impulse", 0.05, [](Channels& x, int)
+    {
+        x[0][0] = 1.0f;
+        x[1][480] = 0.5f;
+    }));
+
+    // Exponential sine sweep, 20 Hz to 20 kHz
+    corpus.push_back(makeSignal("sweep", 1.5, [](Channels& x, int length)
+    {
+        const double f0 = 20.0, f1 = 20000.0, duration = length / sampleRate;
+        const double k = std::log(f1 / f0);
+        for (int i = 0; i < length; ++i)
+        {
+            double t = i / sampleRate;
+            double phase = 2.0 * pi * f0 * duration / k * (std::exp(t / duration * k) - 1.0);
+            x[0][static_cast<size_t>(i)] = x[1][static_cast<size_t>(i)] = 0.5f * static_cast<float>(std::sin(phase));
+        }
+    }));
+
+    corpus.push_back(makeSignal("noise", 1.0, [](Channels& x, int length)
+    {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> dist(-0.3f, 0.3f);
+        for (int i = 0; i < length; ++i)
+            for (auto& ch : x)
+                ch[static_cast<size_t>(i)] = dist(rng);
+    }));
+
+    // Plucked notes with decaying harmonics over a kick, panned apart
+    corpus.push_back(makeSignal("music", 2.0, [](Channels& x, int length)
+    {
+        const double notes[] = { 220.0, 277.18, 329.63, 440.0, 369.99, 293.66, 246.94, 196.0 };
+        const int noteLength = static_cast<int>(0.25 * sampleRate);
+
+        for (int i = 0; i < length; ++i)
+        {
+            int note = i / noteLength;
+            double t = (i % noteLength) / sampleRate;
+            double f = notes[note % 8];
+
+            double pluck = 0.0;
+            for (int h = 1; h <= 6; ++h)
+                pluck += std::sin(2.0 * pi * f * h * t) * std::exp(-t * (4.0 + 3.0 * h)) / h;
+
+            double kt = (i % (2 * noteLength)) / sampleRate;
+            double kick = std::sin(2.0 * pi * (40.0 * kt + 80.0 * (1.0 - std::exp(-kt * 30.0)) / 30.0)) * std::exp(-kt * 12.0);
+
+            x[0][static_cast<size_t>(i)] = static_cast<float>(0.25 * pluck + 0.35 * kick);
+            x[1][static_cast<size_t>(i)] = static_cast<float>(0.15 * pluck + 0.35 * kick);
+        }
+    }));
+
+    return corpus;
+}
+
+// === Patches ===
+
+struct Patch
+{
+    std::string name;
+    DelayEngine::Parameters params;
+    double freezeAtSeconds = -1.0;  // Engage freeze part way through
+    bool mono = false;              // Also comparable on a DelayEngineBank lane
+};
+
+std::vector<Patch> makePatches()
+{
+    // The reference's settings; paths change one thing at a time
+    DelayEngine::Parameters base;
+    base.delayTimeMs = 350.0f;
+    base.delayTimeRightMs = 420.0f;
+    base.feedback = 0.5f;
+    base.mix = 0.5f;
+    base.filterFreq = 8000.0f;
+    base.damping = 0.3f;
+    base.interpolation = InterpolationMode::Hermite;
+    base.saturationAccuracy = SaturationAccuracy::Exact;
+    base.lfoControlRate = false;
+
+    std::vector<Patch> patches;
+
+    patches.push_back({ "clean", base, -1.0, true });
+
+    auto p = base;
+    p.modDepth = 0.4f;
+    p.modRateHz = 1.3f;
+    p.drive = 0.4f;
+    p.filterRes = 0.5f;
+    p.filterMode = FilterMode::BandPass;
+    p.filterFreq = 2000.0f;
+    patches.push_back({ "modulated", p, -1.0, true });
+
+    p = base;
+    p.modDepth = 0.3f;
+    p.modRateHz = 2.0f;
+    p.lfoShape = LFOShape::SmoothRandom;
+    patches.push_back({ "random-mod", p });
+
+    p = base;
+    p.stereoMode = StereoMode::PingPong;
+    p.duckingEnabled = true;
+    p.duckAmount = 0.7f;
+    p.width = 1.5f;
+    p.feedback = 0.7f;
+    patches.push_back({ "pingpong-duck", p });
+
+    p = base;
+    p.multiTap = true;
+    p.numTaps = 4;
+    const float tapTimes[] = { 125.0f, 250.0f, 375.0f, 600.0f };
+    for (size_t t = 0; t < 4; ++t)
+    {
+        p.taps[t].timeMs = tapTimes[t];
+        p.taps[t].level = 0.8f - 0.15f * static_cast<float>(t);
+        p.taps[t].pan = t % 2 ? 0.6f : -0.6f;
+        p.taps[t].feedback = t == 3 ? 0.5f : 0.0f;
+    }
+    patches.push_back({ "multitap", p });
+
+    p = base;
+    p.feedback = 0.6f;
+    patches.push_back({ "freeze", p, 0.5 });
+
+    return patches;
+}
+
+// === Rendering ===
+
+enum class Kernel { Scalar, Block };
+
+Channels renderEngine(const Patch& patch, const DelayEngine::Parameters& params, const Signal& signal,
+                      Kernel kernel, int numChannels)
+{
+    auto engine = std::make_unique<DelayEngine>();
+    engine->prepare(sampleRate, blockSize, DelayStorage::Float32,
+                    numChannels == 1 ? ChannelLayout::mono() : ChannelLayout::stereo());
+
+    auto current = params;
+    engine->setParameters(current);
+    engine->setLFOSeed(lfoSeed);
+    engine->serviceDelayMemory();
+
+    Channels out(signal.channels.begin(), signal.channels.begin() + numChannels);
+    const int length = static_cast<int>(out[0].size());
+    const int freezeAt = patch.freezeAtSeconds >= 0.0 ? static_cast<int>(patch.freezeAtSeconds * sampleRate) : -1;
+
+    for (int pos = 0; pos < length; pos += blockSize)
+    {
+        if (freezeAt >= 0 && pos >= freezeAt && !current.freeze)
+        {
+            current.freeze = true;
+            engine->setParameters(current);
+        }
+
+        const int n = std::min(blockSize, length - pos);
+        float* channels[2] = { out[0].data() + pos, numChannels > 1 ? out[1].data() + pos : nullptr };
+
+        if (kernel == Kernel::Scalar)
+            engine->processScalar(channels, n);
+        else
+            engine->process(channels, n);
+
+        engine->serviceDelayMemory();
+    }
+
+    return out;
+}
+
+// Lane 0 of an 8-lane bank carries the left channel; the other lanes run
+// the right channel so the bank is fully loaded
+Channels renderBank(const DelayEngine::Parameters& params, const Signal& signal)
+{
+    constexpr int lanes = 8;
+
+    auto bank = std::make_unique<DelayEngineBank<lanes>>();
+    bank->prepare(sampleRate, 2000.0f);
+    bank->setSaturationAccuracy(params.saturationAccuracy);
+
+    DelayEngineBank<lanes>::LaneParameters lane;
+    lane.delayTimeMs = params.delayTimeMs;
+    lane.feedback = params.feedback;
+    lane.mix = params.mix;
+    lane.modRateHz = params.modRateHz;
+    lane.modDepth = params.modDepth;
+    lane.filterFreq = params.filterFreq;
+    lane.filterRes = params.filterRes;
+    lane.filterMode = params.filterMode;
+    lane.damping = params.damping;
+    lane.drive = params.drive;
+    lane.inputGain = params.inputGain;
+    lane.outputGain = params.outputGain;
+
+    for (int l = 0; l < lanes; ++l)
+        bank->setParameters(l, lane);
+
+    Channels out(lanes, signal.channels[1]);
+    out[0] = signal.channels[0];
+    const int length = static_cast<int>(out[0].size());
+
+    for (int pos = 0; pos < length; pos += blockSize)
+    {
+        float* ptrs[lanes];
+        for (int l = 0; l < lanes; ++l)
+            ptrs[l] = out[static_cast<size_t>(l)].data() + pos;
+
+        bank->process(ptrs, std::min(blockSize, length - pos));
+    }
+
+    out.resize(1);
+    return out;
+}
+
+// === Metrics ===
+
+void fft(std::vector<std::complex<double>>& data)
+{
+    const size_t n = data.size();
+
+    for (size_t i = 1, j = 0; i < n; ++i)
+    {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+        if (i < j)
+            std::swap(data[i], data[j]);
+    }
+
+    for (size_t len = 2; len <= n; len <<= 1)
+    {
+        const std::complex<double> step = std::polar(1.0, -2.0 * pi / static_cast<double>(len));
+        for (size_t i = 0; i < n; i += len)
+        {
+            std::complex<double> w = 1.0;
+            for (size_t k = 0; k < len / 2; ++k, w *= step)
+            {
+                auto a = data[i + k];
+                auto b = data[i + k + len / 2] * w;
+                data[i + k] = a + b;
+                data[i + k + len / 2] = a - b;
+            }
+        }
+    }
+}
+
+// Third-octave band energies, 25 Hz - 20 kHz, from a Welch estimate
+std::vector<double> bandEnergies(const Channels& x)
+{
+    constexpr size_t frameSize = 4096, hop = frameSize / 2;
+
+    std::vector<double> power(frameSize / 2 + 1, 0.0);
+    std::vector<std::complex<double>> frame(frameSize);
+
+    for (const auto& ch : x)
+    {
+        for (size_t start = 0; start + frameSize <= ch.size(); start += hop)
+        {
+            for (size_t i = 0; i < frameSize; ++i)
+            {
+                double window = 0.5 - 0.5 * std::cos(2.0 * pi * static_cast<double>(i) / frameSize);
+                frame[i] = ch[start + i] * window;
+            }
+
+            fft(frame);
+            for (size_t k = 0; k < power.size(); ++k)
+                power[k] += std::norm(frame[k]);
+        }
+    }
+
+    std::vector<double> bands;
+    for (int b = -16; b <= 13; ++b)
+    {
+        const double centre = 1000.0 * std::pow(2.0, b / 3.0);
+        const double lo = centre * std::pow(2.0, -1.0 / 6.0), hi = centre * std::pow(2.0, 1.0 / 6.0);
+
+        double energy = 0.0;
+        for (size_t k = 0; k < power.size(); ++k)
+        {
+            const double f = static_cast<double>(k) * sampleRate / frameSize;
+            if (f >= lo && f < hi)
+                energy += power[k];
+        }
+        bands.push_back(energy);
+    }
+    return bands;
+}
+
+double toDb(double gain)
+{
+    return 20.0 * std::log10(std::max(gain, 1e-12));
+}
+
+// 30 dB decay time of the tail after the input ends, from its centre time
+// (the energy-weighted mean time, which an exponential decay of 30 dB in T
+// puts at T / 6.9). Echoes make the energy decay curve a staircase, where a
+// threshold crossing jumps a whole repeat on a tiny level change; the
+// centroid moves smoothly with every echo's level and position.
+double decayMs(const Channels& x, int inputLength)
+{
+    double energy = 0.0, moment = 0.0;
+
+    for (const auto& ch : x)
+    {
+        for (size_t i = static_cast<size_t>(inputLength); i < ch.size(); ++i)
+        {
+            const double e = static_cast<double>(ch[i]) * ch[i];
+            energy += e;
+            moment += e * static_cast<double>(i - static_cast<size_t>(inputLength));
+        }
+    }
+
+    if (energy <= 0.0)
+        return 0.0;
+
+    const double centreMs = 1000.0 * moment / energy / sampleRate;
+    return centreMs * 3.0 * std::log(10.0);
+}
+
+struct Bounds
+{
+    double maxAbs;          // Linear, full scale = 1
+    double maxRmsDb;        // RMS of the difference, dBFS
+    double maxSpectralDb;   // Largest third-octave band difference
+    double maxDecayMs;      // Difference in 30 dB decay time
+};
+
+struct Comparison
+{
+    double maxAbs = 0.0, rmsDb = -240.0, spectralDb = 0.0, decayDiffMs = 0.0;
+
+    bool within(const Bounds& b) const
+    {
+        return maxAbs <= b.maxAbs && rmsDb <= b.maxRmsDb && spectralDb <= b.maxSpectralDb && decayDiffMs <= b.maxDecayMs;
+    }
+};
+
+Comparison compare(const Channels& reference, const Channels& test, int inputLength)
+{
+    Comparison c;
+    double sumSquares = 0.0;
+    size_t count = 0;
+
+    for (size_t ch = 0; ch < reference.size(); ++ch)
+    {
+        for (size_t i = 0; i < reference[ch].size(); ++i)
+        {
+            const double d = static_cast<double>(test[ch][i]) - reference[ch][i];
+            c.maxAbs = std::max(c.maxAbs, std::abs(d));
+            sumSquares += d * d;
+        }
+        count += reference[ch].size();
+    }
+    c.rmsDb = toDb(std::sqrt(sumSquares / static_cast<double>(count)));
+
+    // Bands more than 100 dB under the loudest are noise floor
+    const auto refBands = bandEnergies(reference), testBands = bandEnergies(test);
+    const double floor = *std::max_element(refBands.begin(), refBands.end()) * 1e-10;
+    for (size_t b = 0; b < refBands.size(); ++b)
+    {
+        if (refBands[b] > floor)
+            c.spectralDb = std::max(c.spectralDb, std::abs(10.0 * std::log10(std::max(testBands[b], 1e-30) / refBands[b])));
+    }
+
+    c.decayDiffMs = std::abs(decayMs(reference, inputLength) - decayMs(test, inputLength));
+    return c;
+}
+
+// === Paths ===
+
+struct Path
+{
+    std::string name;
+    std::function<void(DelayEngine::Parameters&)> configure;  // From the reference settings
+    Bounds bounds;
+    bool bank = false;
+};
+
+// Each path's bounds are its measured worst case over the corpus plus
+// headroom, so a regression in any one path fails instead of hiding under
+// a shared tolerance.
+std::vector<Path> makePaths()
+{
+    // Exact paths do the reference's arithmetic in the same order (the block
+    // path and the bank compute the modulation offset in its own pass, so
+    // fused multiply-adds cannot move a read position). They differ only by
+    // float rounding, e.g. where Automatic reads with Integer or Thiran
+    // instead of Hermite. Measured at most 2.1e-7 and -158 dB, with identical spectra
+    // and decay, with and without -mfma. 1e-5 leaves 50x for other compilers
+    // yet fails on any real change in a read or the feedback chain.
+    const Bounds exact { 1e-5, -120.0, 0.01, 0.1 };
+
+    // High tier: its rational tanh is within 7.3e-5 of tanh, so that is the
+    // most a sample can move before the feedback gain; measured 3.3e-7 and
+    // -157 dB at the corpus's drive.
+    const Bounds highTanh { 1e-4, -110.0, 0.01, 0.1 };
+
+    // Fast tier: its polynomial is within 1.1e-2 of tanh, less after the
+    // feedback gain and mix. Measured 1.2e-3, -73 dB, 0.04 dB and 15 ms.
+    const Bounds fastTanh { 5e-3, -65.0, 0.2, 25.0 };
+
+    // Control-rate LFO: the shape is exact every 32 samples and linear in
+    // between, so the modulation is off by the shape's curvature over that
+    // interval (5e-6 for the corpus's 1.3 Hz sine). That moves the read by
+    // about 2e-3 samples, and the error scales with the signal's slope.
+    // Measured 2.7e-3, -83 dB, 0.007 dB and 0.4 ms.
+    const Bounds controlRateLfo { 5e-3, -75.0, 0.05, 1.0 };
+
+    return {
+        { "block",               [](auto&) {},                                                          exact },
+        { "block/interp-auto",   [](auto& p) { p.interpolation = InterpolationMode::Automatic; },        exact },
+        { "block/tanh-high",     [](auto& p) { p.saturationAccuracy = SaturationAccuracy::High; },       highTanh },
+        { "block/tanh-fast",     [](auto& p) { p.saturationAccuracy = SaturationAccuracy::Fast; },       fastTanh },
+        { "block/lfo-control",   [](auto& p) { p.lfoControlRate = true; },                               controlRateLfo },
+        { "bank8",               [](auto& p) { p.oversampling = 1; },                                    exact, true }
+    };
+}
+
+// === Repeat timing ===
+
+// Oversampled saturation and limiting sit inside the feedback loop. With
+// drive up, an impulse's repeats must stay as far apart as they are with
+// oversampling off; uncompensated, their latency moved each repeat 6-8
+// samples late. The delay is a whole number of samples, so automatic
+// interpolation must also keep the fractional compensation rather than
+// round it away; it is held to the Hermite block path at the same factor.
+constexpr int timingPeriod = 4800;          // 100 ms
+constexpr int timingImpulseAt = 480;        // Past the oversamplers' fade in
+constexpr double maxSpacingError = 0.25;    // Samples per repeat vs 1x; measured < 0.11
+constexpr double maxAutoSpacingError = 0.02; // vs Hermite; measured < 0.004, rounded reads 0.07-0.14
+
+// Energy centroid of repeat k, in a window one period wide around where the
+// delay time puts it
+double echoCentroid(const std::vector<float>& x, int k)
+{
+    const int centre = timingImpulseAt + k * timingPeriod;
+    const int end = std::min(static_cast<int>(x.size()), centre + timingPeriod / 2);
+
+    double sum = 0.0, weight = 0.0;
+    for (int i = std::max(0, centre - timingPeriod / 2); i < end; ++i)
+    {
+        const double e = static_cast<double>(x[static_cast<size_t>(i)]) * x[static_cast<size_t>(i)];
+        sum += e * i;
+        weight += e;
+    }
+
+    return weight > 0.0 ? sum / weight : 0.0;
+}
+
+// Mean samples between repeats 2 and 16; the first is left out, as it only
+// passes the write limiter
+double repeatSpacing(const Channels& out)
+{
+    constexpr int first = 2, last = 16;
+    return (echoCentroid(out[0], last) - echoCentroid(out[0], first)) / (last - first);
+}
+
+// Returns the number of failures
+int checkRepeatTiming(const std::string& filter, int& comparisons)
+{
+    Patch patch { "drive-repeats", {} };
+    auto& base = patch.params;
+    base.delayTimeMs = base.delayTimeRightMs = 1000.0f * timingPeriod / sampleRate;
+    base.feedback = 0.8f;
+    base.mix = 1.0f;
+    base.drive = 0.5f;
+    base.filterFreq = 8000.0f;
+    base.damping = 0.3f;
+    base.interpolation = InterpolationMode::Hermite;
+    base.saturationAccuracy = SaturationAccuracy::Exact;
+    base.lfoControlRate = false;
+
+    const auto signal = makeSignal("impulse", 0.05, [](Channels& x, int)
+    {
+        x[0][timingImpulseAt] = x[1][timingImpulseAt] = 0.5f;
+    });
+
+    auto params = base;
+    params.oversampling = 1;
+    const double reference = repeatSpacing(renderEngine(patch, params, signal, Kernel::Scalar, 2));
+
+    struct Variant
+    {
+        const char* name;
+        Kernel kernel;
+        InterpolationMode interpolation;
+        bool againstHermite;    // Compared to block/osN rather than 1x
+    };
+
+    const Variant variants[] = {
+        { "scalar",     Kernel::Scalar, InterpolationMode::Hermite,   false },
+        { "block",      Kernel::Block,  InterpolationMode::Hermite,   false },
+        { "block/auto", Kernel::Block,  InterpolationMode::Automatic, true }
+    };
+
+    int failures = 0;
+    for (int factor : { 2, 4 })
+    {
+        params.oversampling = factor;
+        params.interpolation = InterpolationMode::Hermite;
+        double hermite = 0.0;
+
+        for (const auto& variant : variants)
+        {
+            const std::string path = std::string(variant.name) + "/os" + std::to_string(factor);
+            if (!filter.empty() && (path + " " + patch.name + " " + signal.name).find(filter) == std::string::npos)
+                continue;
+
+            if (variant.againstHermite && hermite == 0.0)
+                hermite = repeatSpacing(renderEngine(patch, params, signal, Kernel::Block, 2));
+
+            auto variantParams = params;
+            variantParams.interpolation = variant.interpolation;
+            const double spacing = repeatSpacing(renderEngine(patch, variantParams, signal, variant.kernel, 2));
+            if (variant.kernel == Kernel::Block && variant.interpolation == InterpolationMode::Hermite)
+                hermite = spacing;
+
+            const double expected = variant.againstHermite ? hermite : reference;
+            const double maxError = variant.againstHermite ? maxAutoSpacingError : maxSpacingError;
+            const bool pass = std::abs(spacing - expected) <= maxError;
+
+            ++comparisons;
+            if (!pass)
+                ++failures;
+
+            std::printf("%-20s %-14s %-8s %10.3f %9.3f %s%s\n", path.c_str(), patch.name.c_str(), signal.name.c_str(),
+                        spacing, expected, variant.againstHermite ? "block" : "1x", pass ? "" : "  FAIL");
+        }
+    }
+
+    return failures;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+#if defined(__SSE__) || defined(_M_X64)
+    _mm_setcsr(_mm_getcsr() | 0x8040);
+#endif
+
+    std::string filter;
+    Bounds overrides { -1.0, 1.0, -1.0, -1.0 };
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const double value = i + 1 < argc ? std::atof(argv[i + 1]) : 0.0;
+
+        if (arg == "--filter" && i + 1 < argc)
+            filter = argv[++i];
+        else if (arg == "--max-abs")
+            overrides.maxAbs = value, ++i;
+        else if (arg == "--max-rms-db")
+            overrides.maxRmsDb = value, ++i;
+        else if (arg == "--max-spectral-db")
+            overrides.maxSpectralDb = value, ++i;
+        else if (arg == "--max-decay-ms")
+            overrides.maxDecayMs = value, ++i;
+        else
+        {
+            std::fprintf(stderr, "Usage: chronos_validate [--filter text] [--max-abs x] [--max-rms-db x]\n"
+                                 "                        [--max-spectral-db x] [--max-decay-ms x]\n");
+            return arg == "--help" ? 0 : 2;
+        }
+    }
+
+    const auto corpus = makeCorpus();
+    const auto patches = makePatches();
+    int failures = 0, comparisons = 0;
+
+    std::printf("%-20s %-14s %-8s %10s %9s %9s %9s\n", "path", "patch", "signal", "max_abs", "rms_dB", "spec_dB", "decay_ms");
+
+    for (const auto& patch : patches)
+    {
+        for (const auto& signal : corpus)
+        {
+            Channels stereoReference, monoReference;
+
+            for (const auto& path : makePaths())
+            {
+                const std::string label = path.name + " " + patch.name + " " + signal.name;
+                if (!filter.empty() && label.find(filter) == std::string::npos)
+                    continue;
+                if (path.bank && !patch.mono)
+                    continue;
+
+                auto params = patch.params;
+                path.configure(params);
+
+                // The reference runs with the path's settings that change the
+                // signal chain itself (the bank has no oversampling)
+                auto referenceParams = patch.params;
+                referenceParams.oversampling = params.oversampling;
+
+                Channels test;
+                const Channels* reference = nullptr;
+
+                if (path.bank)
+                {
+                    if (monoReference.empty())
+                        monoReference = renderEngine(patch, referenceParams, signal, Kernel::Scalar, 1);
+                    reference = &monoReference;
+                    test = renderBank(params, signal);
+                }
+                else
+                {
+                    if (stereoReference.empty())
+                        stereoReference = renderEngine(patch, referenceParams, signal, Kernel::Scalar, 2);
+                    reference = &stereoReference;
+                    test = renderEngine(patch, params, signal, Kernel::Block, 2);
+                }
+
+                Bounds bounds = path.bounds;
+                if (overrides.maxAbs >= 0.0)        bounds.maxAbs = overrides.maxAbs;
+                if (overrides.maxRmsDb <= 0.0)      bounds.maxRmsDb = overrides.maxRmsDb;
+                if (overrides.maxSpectralDb >= 0.0) bounds.maxSpectralDb = overrides.maxSpectralDb;
+                if (overrides.maxDecayMs >= 0.0)    bounds.maxDecayMs = overrides.maxDecayMs;
+
+                const auto c = compare(*reference, test, signal.inputLength);
+                const bool pass = c.within(bounds);
+
+                ++comparisons;
+                if (!pass)
+                    ++failures;
+
+                std::printf("%-20s %-14s %-8s %10.3g %9.1f %9.3f %9.2f%s\n", path.name.c_str(), patch.name.c_str(),
+                            signal.name.c_str(), c.maxAbs, c.rmsDb, c.spectralDb, c.decayDiffMs, pass ? "" : "  FAIL");
+            }
+        }
+    }
+
+    std::printf("\n%-20s %-14s %-8s %10s %9s %s\n", "path", "patch", "signal", "spacing", "expected", "vs");
+    failures += checkRepeatTiming(filter, comparisons);
+
+    std::printf("\n%d of %d comparisons within bounds\n", comparisons - failures, comparisons);
+    return failures > 0 ? 1 : 0;
+}